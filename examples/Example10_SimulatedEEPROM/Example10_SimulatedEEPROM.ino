@@ -0,0 +1,100 @@
+/*
+  Run the library against a simulated EEPROM and measure the bus cost of reads and writes
+  SparkFun Electronics
+  Date: October 16th, 2026
+  License: This code is public domain but you buy me a beer if you use this
+  and we meet someday (Beerware license).
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/18355
+
+  This example demonstrates how to plug a different bus transport into the library.
+  SimulatedEEPROM behaves like a 24xx32 sitting on the I2C bus: it wraps page writes,
+  NACKs while a page is being programmed, and counts every transaction. This makes it
+  possible to compare the cost of different access patterns without any hardware.
+
+  The simulated memory lives in RAM so pick a part that fits your board. A 24xx32 needs 4096 bytes.
+
+  Hardware Connections:
+  None! Load this sketch on any board with at least 8k of RAM
+  Open output window at 115200bps
+*/
+
+#include "SparkFun_External_EEPROM.h" // Click here to get the library: http://librarymanager/All#SparkFun_External_EEPROM
+#include "SparkFun_External_EEPROM_Simulator.h"
+
+ExternalEEPROM myMem;
+SimulatedEEPROM simulatedPart;
+
+uint8_t simulatedMemory[4096]; // Backing storage for a 24xx32
+
+void setup()
+{
+  Serial.begin(115200);
+  //delay(250); //Often needed for ESP based platforms
+  Serial.println("Simulated EEPROM example");
+
+  simulatedPart.begin(simulatedMemory, 32); // Behave like a 24xx32
+  simulatedPart.setTimeSource(micros); // Let the page program time (tWR) pass in real time
+  simulatedPart.setWriteTimeUs(5000);
+  simulatedPart.setBusClock(400000); // Only used for cost accounting
+
+  myMem.setMemoryType(32);
+
+  if (myMem.begin(0b1010000, simulatedPart) == false)
+  {
+    Serial.println("Simulated memory did not respond. Freezing.");
+    while (true)
+      ;
+  }
+  Serial.println("Simulated memory detected!");
+
+  uint8_t myData[256];
+  for (int x = 0; x < sizeof(myData); x++)
+    myData[x] = x;
+
+  // Write one byte at a time
+  simulatedPart.resetStats();
+  unsigned long startTime = micros();
+  for (int x = 0; x < 64; x++)
+    myMem.write(x, myData[x]);
+  printCost("64 single byte writes", micros() - startTime);
+
+  // Write the same amount in one call
+  simulatedPart.resetStats();
+  startTime = micros();
+  myMem.write(64, myData, 64);
+  printCost("One 64 byte write", micros() - startTime);
+
+  // Read it all back
+  uint8_t readData[256];
+  simulatedPart.resetStats();
+  startTime = micros();
+  myMem.read(0, readData, sizeof(readData));
+  printCost("One 256 byte read", micros() - startTime);
+}
+
+void loop()
+{
+}
+
+void printCost(const char *testName, unsigned long elapsedTime)
+{
+  struct_simulatedEEPROMStats stats = simulatedPart.getStats();
+
+  Serial.println();
+  Serial.println(testName);
+  Serial.print("  Transactions: ");
+  Serial.println(stats.transactions);
+  Serial.print("  Page programs: ");
+  Serial.println(stats.pageWrites);
+  Serial.print("  NACKs while busy: ");
+  Serial.println(stats.nacks);
+  Serial.print("  Bytes to device: ");
+  Serial.println(stats.bytesToDevice);
+  Serial.print("  Bytes from device: ");
+  Serial.println(stats.bytesFromDevice);
+  Serial.print("  Bus time (us): ");
+  Serial.println(stats.busTime_us);
+  Serial.print("  Elapsed time (us): ");
+  Serial.println(elapsedTime);
+}
@@ -0,0 +1,90 @@
+/*
+  Write to an external I2C EEPROM without blocking the main loop
+  SparkFun Electronics
+  Date: October 16th, 2026
+  License: This code is public domain but you buy me a beer if you use this
+  and we meet someday (Beerware license).
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/18355
+
+  This example demonstrates how to queue a large write with writeAsync() and let
+  update() record it one page at a time while loop() keeps running. A normal write()
+  of the same data blocks for the write time of every page.
+
+  The I2C EEPROM should have all its ADR pins set to GND (0). This is default
+  on the Qwiic board.
+
+  Hardware Connections:
+  Plug the SparkFun Qwiic EEPROM to an Uno, Artemis, or other Qwiic equipped board
+  Load this sketch
+  Open output window at 115200bps
+*/
+
+#include <Wire.h>
+
+#include "SparkFun_External_EEPROM.h" // Click here to get the library: http://librarymanager/All#SparkFun_External_EEPROM
+ExternalEEPROM myMem;
+
+unsigned long loopCount = 0;
+unsigned long startTime;
+
+// Called by the library each time a queued write has been sent to the device
+void writeComplete(uint32_t eepromLocation, uint16_t length, int result)
+{
+  Serial.print("Queued write of ");
+  Serial.print(length);
+  Serial.print(" bytes to location ");
+  Serial.print(eepromLocation);
+  Serial.print(result == 0 ? " sent in " : " failed after ");
+  Serial.print(millis() - startTime);
+  Serial.print("ms. Main loop ran ");
+  Serial.print(loopCount);
+  Serial.println(" times in the meantime.");
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  //delay(250); //Often needed for ESP based platforms
+  Serial.println("Qwiic EEPROM async write example");
+
+  Wire.begin();
+
+  // Default to the Qwiic 24xx512 EEPROM: https://www.sparkfun.com/products/18355
+  myMem.setMemoryType(512); // Valid types: 0, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1025, 2048
+
+  if (myMem.begin() == false)
+  {
+    Serial.println("No memory detected. Freezing.");
+    while (true)
+      ;
+  }
+  Serial.println("Memory detected!");
+
+  // The queue holds a copy of the data so the caller's buffer can be reused right away
+  if (myMem.enableAsyncWrite(300) == false)
+  {
+    Serial.println("Not enough RAM for the write queue. Freezing.");
+    while (true)
+      ;
+  }
+  myMem.setAsyncWriteCallback(writeComplete);
+
+  uint8_t myData[256];
+  for (int x = 0; x < sizeof(myData); x++)
+    myData[x] = x;
+
+  startTime = millis();
+  myMem.writeAsync(0, myData, sizeof(myData)); // Returns immediately
+
+  // Reads issued before the data is recorded still return the queued data
+  Serial.print("Location 100 reads (should be 100): ");
+  Serial.println(myMem.read(100));
+}
+
+void loop()
+{
+  myMem.update(); // Sends the next page once the EEPROM has finished the previous one
+
+  loopCount++; // Do other work here
+}
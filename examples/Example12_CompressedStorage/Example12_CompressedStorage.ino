@@ -0,0 +1,157 @@
+/*
+  Store lookup tables and text compressed to save space and write time
+  SparkFun Electronics
+  Date: October 16th, 2026
+  License: This code is public domain but you buy me a beer if you use this
+  and we meet someday (Beerware license).
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/18355
+
+  This example stores a sine table and a block of menu text twice: once with putBlob()
+  and once with putCompressed(). Every page write costs ~5ms so fewer bytes stored means
+  a faster write. The price is CPU time to compress and decompress, which is measured
+  separately by running the codec on a RAM copy.
+
+  Current benchmarking, desktop PC against a simulated 24xx512 (see Example10) at 400kHz:
+  Sine table, 256 bytes: 135 bytes stored instead of 258. 6 page writes instead of 12.
+    Write 31ms instead of 63ms. 321 bytes on the bus instead of 558.
+    Compress 30us, decompress 1.5us.
+  Menu text, 242 bytes: 162 bytes stored instead of 244. 7 page writes instead of 10.
+    Write 36ms instead of 51ms. 350 bytes on the bus instead of 526.
+    Compress 55us, decompress 1.3us.
+  Run this sketch to see the numbers for your board. The codec is slower on a small processor
+  but each chunk is compressed while the previous page programs, so it is mostly hidden behind tWR.
+
+  The I2C EEPROM should have all its ADR pins set to GND (0). This is default
+  on the Qwiic board.
+
+  Hardware Connections:
+  Plug the SparkFun Qwiic EEPROM to an Uno, Artemis, or other Qwiic equipped board
+  Load this sketch
+  Open output window at 115200bps
+*/
+
+#include <Wire.h>
+
+#include "SparkFun_External_EEPROM.h" // Click here to get the library: http://librarymanager/All#SparkFun_External_EEPROM
+ExternalEEPROM myMem;
+
+uint8_t sineTable[256];
+
+char menuText[] = "1) Write file to EEPROM\n"
+                  "2) Read EEPROM to file\n"
+                  "3) Verify file against EEPROM\n"
+                  "4) Write file to EEPROM and verify\n"
+                  "5) Read EEPROM and print to terminal\n"
+                  "6) Set EEPROM memory type\n"
+                  "7) Set EEPROM page size\n"
+                  "8) Set EEPROM page write time\n"
+                  "x) Exit menu\n";
+
+// Sized to fit an Uno
+uint8_t readBack[300];
+uint8_t compressed[310]; // Room for incompressible data, which grows by one byte in 128
+
+void setup()
+{
+  Serial.begin(115200);
+  //delay(250); //Often needed for ESP based platforms
+  Serial.println("Qwiic EEPROM compressed storage example");
+
+  Wire.begin();
+  Wire.setClock(400000);
+
+  // Default to the Qwiic 24xx512 EEPROM: https://www.sparkfun.com/products/18355
+  myMem.setMemoryType(512); // Valid types: 0, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1025, 2048
+
+  if (myMem.begin() == false)
+  {
+    Serial.println("No memory detected. Freezing.");
+    while (true)
+      ;
+  }
+  Serial.println("Memory detected!");
+
+  // Two periods of a sine wave
+  for (int x = 0; x < sizeof(sineTable); x++)
+    sineTable[x] = 128 + 127 * sin(x * 2 * PI / 128);
+
+  compare("Sine table", sineTable, sizeof(sineTable));
+  compare("Menu text", (uint8_t *)menuText, strlen(menuText));
+}
+
+void loop()
+{
+}
+
+// Store data both ways and print what each costs
+void compare(const char *name, const uint8_t *data, uint16_t length)
+{
+  Serial.println();
+  Serial.println(name);
+
+  // Plain
+  unsigned long startTime = micros();
+  uint32_t plainEnd = myMem.putBlob(0, data, length);
+  while (myMem.isBusy()) // Include the last page write
+    ;
+  unsigned long plainWrite = micros() - startTime;
+
+  startTime = micros();
+  myMem.getBlob(0, readBack, sizeof(readBack));
+  unsigned long plainRead = micros() - startTime;
+
+  // Compressed
+  startTime = micros();
+  uint32_t compressedEnd = myMem.putCompressed(1024, data, length);
+  while (myMem.isBusy())
+    ;
+  unsigned long compressedWrite = micros() - startTime;
+
+  memset(readBack, 0, sizeof(readBack));
+  startTime = micros();
+  myMem.getCompressed(1024, readBack, sizeof(readBack));
+  unsigned long compressedRead = micros() - startTime;
+
+  if (memcmp(readBack, data, length) != 0)
+    Serial.println("  Compressed data did not read back correctly!");
+
+  // The codec alone, without the bus
+  startTime = micros();
+  uint16_t position = 0;
+  uint16_t compressedSize = 0;
+  while (position < length)
+    compressedSize += externalEEPROMLzCompress(data, length, position, compressed + compressedSize,
+                                               sizeof(compressed) - compressedSize);
+  unsigned long compressTime = micros() - startTime;
+
+  startTime = micros();
+  struct_lzDecoder decoder;
+  externalEEPROMLzBegin(decoder);
+  externalEEPROMLzDecompress(decoder, compressed, compressedSize, readBack, length);
+  unsigned long decompressTime = micros() - startTime;
+
+  Serial.print("  Stored bytes: ");
+  Serial.print(plainEnd);
+  Serial.print(" plain, ");
+  Serial.print(compressedEnd - 1024);
+  Serial.println(" compressed");
+
+  Serial.print("  Write time (us): ");
+  Serial.print(plainWrite);
+  Serial.print(" plain, ");
+  Serial.print(compressedWrite);
+  Serial.println(" compressed");
+
+  Serial.print("  Read time (us): ");
+  Serial.print(plainRead);
+  Serial.print(" plain, ");
+  Serial.print(compressedRead);
+  Serial.println(" compressed");
+
+  Serial.print("  CPU time (us): ");
+  Serial.print(compressTime);
+  Serial.print(" to compress, ");
+  Serial.print(decompressTime);
+  Serial.println(" to decompress");
+}
@@ -33,6 +33,7 @@
 
   Current benchmarking:
   112586 bytes takes 3.801s to write or 29.6kB/s
+  Re-writing the same file with a few changed bytes only writes the pages that changed
 
   TODO:
   Modify all library features config from menu
@@ -53,6 +54,9 @@ const byte PIN_MICROSD_CHIP_SELECT = 10;
 #include "SparkFun_External_EEPROM.h" // Click here to get the library: http://librarymanager/All#SparkFun_External_EEPROM
 ExternalEEPROM myMem;
 
+#include "SparkFun_External_EEPROM_Programmer.h"
+ExternalEEPROMProgrammer programmer; //Reads the file while pages program, skips pages that already match
+
 const byte EEPROM_ADDRESS = 0b1010000; //The 7-bit unshifted address for the 24LC1025
 String binFileName = "data.bin";       //File to write to the EEPROM
 
@@ -191,11 +195,50 @@ void autoProgram()
   }
 }
 
+//State for compareBurst()
+File verifyFile;
+int verifyErrors = 0;
+
+//Called by readVisit() with each burst read from the EEPROM
+//Compares it against the next bytes of the file. Returning false stops the read.
+bool compareBurst(uint32_t location, const uint8_t *onEEPROM, uint16_t length)
+{
+  for (int x = 0; x < length; x++)
+  {
+    uint8_t onFile = verifyFile.read();
+
+    if (onEEPROM[x] != onFile)
+    {
+      Serial.print(F("Verify failed at location 0x"));
+      Serial.print(location + x, HEX);
+      Serial.print(F(". Read 0x"));
+      Serial.print(onEEPROM[x], HEX);
+      Serial.print(F(", expected 0x"));
+      Serial.print(onFile, HEX);
+      Serial.println(F("."));
+      if (verifyErrors++ > 4)
+        return (false);
+    }
+  }
+
+  uint32_t dotSize = myMem.getPageSizeBytes() * 128UL;
+  if ((location + length) / dotSize != location / dotSize)
+    Serial.print(F("."));
+
+  if (digitalRead(PIN_STAT_LED) == LOW)
+    digitalWrite(PIN_STAT_LED, HIGH);
+  else
+    digitalWrite(PIN_STAT_LED, LOW);
+
+  return (true);
+}
+
 //Given a file name, verify the contents of the EEPROM match the file contents
+//The EEPROM is read in I2C sized bursts by readVisit(), which hands each one to compareBurst()
 bool verifyFileOnEEPROM(char *fileName)
 {
-  File binFile = SD.open(fileName);
-  if (binFile == false)
+  verifyFile = SD.open(fileName);
+  if (verifyFile == false)
   {
     Serial.print(F("Programming file '"));
     Serial.print((String)fileName);
@@ -204,60 +247,21 @@ bool verifyFileOnEEPROM(char *fileName)
   }
   Serial.println(F("Verification file opened"));
 
-  int error = 0;
-  uint32_t EEPROMLocation = 0;
-  uint8_t *onEEPROM = (uint8_t *)malloc(myMem.getPageSizeBytes()); //Create a buffer to hold a page
-
-  while (binFile.available())
-  {
-    uint8_t bytesToRead = myMem.getPageSizeBytes();
-
-    if (EEPROMLocation + bytesToRead > myMem.getMemorySizeBytes())
-      bytesToRead = myMem.getMemorySizeBytes() - EEPROMLocation;
-
-    if (bytesToRead > binFile.available())
-      bytesToRead = binFile.available();
+  verifyErrors = 0;
+  uint32_t bytesToVerify = verifyFile.size();
+  if (bytesToVerify > myMem.getMemorySizeBytes())
+    bytesToVerify = myMem.getMemorySizeBytes();
 
-    //myMem.get(EEPROMLocation, onEEPROM); //Location, data
-    myMem.read(EEPROMLocation, onEEPROM, myMem.getPageSizeBytes()); //Location, data
-
-    //Verify what was read from the EEPROM matches the file
-    for (int x = 0; x < bytesToRead; x++)
-    {
-      uint8_t onFile = binFile.read();
-
-      if (onEEPROM[x] != onFile)
-      {
-        Serial.print(F("Verify failed at location 0x"));
-        Serial.print(EEPROMLocation + x, HEX);
-        Serial.print(F(". Read 0x"));
-        Serial.print(onEEPROM[x], HEX);
-        Serial.print(F(", expected 0x"));
-        Serial.print(onFile, HEX);
-        Serial.println(F("."));
-        if (error++ > 4)
-        {
-          binFile.close();
-          return (false);
-        }
-      }
-    }
+  myMem.readVisit(0, bytesToVerify, compareBurst); //Location, length, callback
+  verifyFile.close();
 
-    EEPROMLocation += bytesToRead;
-
-    if (EEPROMLocation % (myMem.getPageSizeBytes() * 128) == 0)
-      Serial.print(F("."));
-
-    if (digitalRead(PIN_STAT_LED) == LOW)
-      digitalWrite(PIN_STAT_LED, HIGH);
-    else
-      digitalWrite(PIN_STAT_LED, LOW);
+  if (verifyErrors > 0)
+  {
+    Serial.println(F("Verification FAILED!"));
+    return (false);
   }
 
   Serial.println(F("Verification PASSED!"));
-
-  binFile.close();
-  free(onEEPROM);
   return (true);
 }
 
@@ -294,50 +298,47 @@ bool writeFileToEEPROM(char *fileName)
   Serial.print((timePerDataTransfer + timePerPageWrite) * writesRequired, 3);
   Serial.println(F("s"));
 
-  uint8_t *buffer = (uint8_t *)malloc(myMem.getPageSizeBytes()); //Create a buffer to hold a page
-  uint8_t bufferLocation = 0;
-
-  uint32_t EEPROMLocation = 0;
-
-  long startTime = millis();
-  while (binFile.available())
+  if (programmer.begin(myMem) == false)
   {
-    buffer[bufferLocation++] = binFile.read();
-
-    //If the buffer if full, record to EEPROM
-    if (bufferLocation == myMem.getPageSizeBytes())
-    {
-      bufferLocation = 0;
-
-      //Record buffer to EEPROM
-      myMem.write(EEPROMLocation, buffer, myMem.getPageSizeBytes()); //Location, data
-
-      EEPROMLocation += myMem.getPageSizeBytes();
-
-      if (EEPROMLocation % (myMem.getPageSizeBytes() * 128) == 0)
-        Serial.print(F("."));
-
-      if (digitalRead(PIN_STAT_LED) == LOW)
-        digitalWrite(PIN_STAT_LED, HIGH);
-      else
-        digitalWrite(PIN_STAT_LED, LOW);
-    }
+    Serial.println(F("Not enough RAM for the programmer"));
+    binFile.close();
+    return (false);
   }
+  programmer.setProgressCallback(printProgress);
 
-  //Write anything remaining in the buffer
-  if (bufferLocation > 0)
-    myMem.write(EEPROMLocation, buffer, bufferLocation); //Location, data, length
-
-  long endTime = millis();
+  bool success = programmer.program(0, binFile, binFile.size()); //Location, source, length
 
+  struct_programmerStats stats = programmer.getStats();
   Serial.println();
   Serial.print(F("Write complete. Elapsed time: "));
-  Serial.print((endTime - startTime) / 1000.0, 3);
-  Serial.println(F("s"));
+  Serial.print(stats.elapsed_ms / 1000.0, 3);
+  Serial.print(F("s, "));
+  Serial.print(programmer.getBytesPerSecond());
+  Serial.println(F(" bytes/s"));
+  Serial.print(F("Pages written: "));
+  Serial.print(stats.pagesWritten);
+  Serial.print(F(" Pages already correct: "));
+  Serial.print(stats.pagesSkipped);
+  Serial.print(F(" Pages rewritten: "));
+  Serial.print(stats.pagesRewritten);
+  Serial.print(F(" Pages failed: "));
+  Serial.println(stats.pagesFailed);
 
   binFile.close();
-  free(buffer);
-  return (true);
+  programmer.end();
+  return (success);
+}
+
+//Print a dot every 128 pages and blink the LED
+void printProgress(uint32_t bytesDone, uint32_t bytesTotal)
+{
+  if (bytesDone % (myMem.getPageSizeBytes() * 128) == 0)
+    Serial.print(F("."));
+
+  if (digitalRead(PIN_STAT_LED) == LOW)
+    digitalWrite(PIN_STAT_LED, HIGH);
+  else
+    digitalWrite(PIN_STAT_LED, LOW);
 }
 
 void beginSD()
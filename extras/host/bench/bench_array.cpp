@@ -0,0 +1,87 @@
+// 16kB write to 1, 2, 4 and 8 simulated 24xx512s on one 400kHz bus, concatenated and striped in 128 bytes
+
+#include <stdio.h>
+
+#include "SparkFun_External_EEPROM_Array.h"
+#include "SparkFun_External_EEPROM_Simulator.h"
+
+#define MAX_CHIPS 8
+
+// One bus shared by every part: each transaction advances the clock by the time it held the bus
+class SharedBus : public ExternalEEPROMTransport
+{
+  public:
+    SimulatedEEPROM *parts[MAX_CHIPS];
+
+    void beginTransmission(uint8_t i2cAddress)
+    {
+        current = parts[i2cAddress - 0x50];
+        current->beginTransmission(i2cAddress);
+    }
+    size_t write(uint8_t dataToWrite)
+    {
+        return (current->write(dataToWrite));
+    }
+    uint8_t endTransmission(bool sendStop = true)
+    {
+        uint32_t busTime_us = current->getStats().busTime_us;
+        uint8_t result = current->endTransmission(sendStop);
+        delayMicroseconds(current->getStats().busTime_us - busTime_us);
+        return (result);
+    }
+    size_t requestFrom(uint8_t i2cAddress, size_t length)
+    {
+        current = parts[i2cAddress - 0x50];
+        uint32_t busTime_us = current->getStats().busTime_us;
+        size_t result = current->requestFrom(i2cAddress, length);
+        delayMicroseconds(current->getStats().busTime_us - busTime_us);
+        return (result);
+    }
+    int read()
+    {
+        return (current->read());
+    }
+
+  private:
+    SimulatedEEPROM *current = nullptr;
+};
+
+static uint8_t memory[MAX_CHIPS][65536];
+static uint8_t image[16384];
+
+static unsigned long run(int chips, uint32_t stripeSize)
+{
+    static SimulatedEEPROM sims[MAX_CHIPS];
+    static ExternalEEPROM devices[MAX_CHIPS];
+    SharedBus bus;
+    ExternalEEPROMArray array;
+    for (int x = 0; x < chips; x++)
+    {
+        sims[x].begin(memory[x], 65536, 128, 2, 0x50 + x);
+        sims[x].setTimeSource(micros);
+        sims[x].setBusClock(400000);
+        bus.parts[x] = &sims[x];
+        devices[x] = ExternalEEPROM();
+        devices[x].setMemoryType(512);
+        devices[x].begin(0x50 + x, bus);
+        array.addDevice(devices[x]);
+    }
+    array.setStripeSize(stripeSize);
+
+    unsigned long startTime = micros();
+    array.write(1000, image, sizeof(image));
+    return (micros() - startTime);
+}
+
+int main()
+{
+    for (uint32_t x = 0; x < sizeof(image); x++)
+        image[x] = rand();
+    for (int chips = 1; chips <= MAX_CHIPS; chips *= 2)
+    {
+        unsigned long concatenated = run(chips, 0);
+        unsigned long striped = run(chips, 128);
+        printf("%d chips: concatenated %7luus, striped %7luus\n", chips, concatenated, striped);
+    }
+    return (0);
+}
@@ -0,0 +1,108 @@
+// Example12's comparison on the host: a sine table and menu text stored with putBlob() and with
+// putCompressed() on a 24xx512 at 400kHz with tWR = 5ms. CPU times are wall clock on this machine.
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+#include "SparkFun_External_EEPROM.h"
+#include "SparkFun_External_EEPROM_Simulator.h"
+
+static uint8_t memory[65536];
+static SimulatedEEPROM sim;
+static ExternalEEPROM myMem;
+
+static uint8_t sineTable[256];
+static char menuText[] = "1) Write file to EEPROM\n"
+                         "2) Read EEPROM to file\n"
+                         "3) Verify file against EEPROM\n"
+                         "4) Write file to EEPROM and verify\n"
+                         "5) Read EEPROM and print to terminal\n"
+                         "6) Set EEPROM memory type\n"
+                         "7) Set EEPROM page size\n"
+                         "8) Set EEPROM page write time\n"
+                         "x) Exit menu\n";
+static uint8_t readBack[300], compressed[310];
+
+static double wallMicros()
+{
+    return (std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Time from the first byte to the end of the last page write
+static unsigned long waitForWrite(unsigned long startTime)
+{
+    while (myMem.isBusy())
+        delayMicroseconds(50);
+    return (micros() - startTime);
+}
+
+static void compare(const char *name, const uint8_t *data, uint16_t length)
+{
+    sim.resetStats();
+    unsigned long startTime = micros();
+    uint32_t plainEnd = myMem.putBlob(0, data, length);
+    unsigned long plainWrite = waitForWrite(startTime);
+    myMem.getBlob(0, readBack, sizeof(readBack));
+    struct_simulatedEEPROMStats plain = sim.getStats();
+
+    sim.resetStats();
+    startTime = micros();
+    uint32_t compressedEnd = myMem.putCompressed(1024, data, length);
+    unsigned long compressedWrite = waitForWrite(startTime);
+    myMem.getCompressed(1024, readBack, sizeof(readBack));
+    struct_simulatedEEPROMStats packed = sim.getStats();
+    if (memcmp(readBack, data, length) != 0)
+        printf("  Compressed data did not read back correctly!\n");
+
+    // The codec alone, averaged over many runs
+    const int runs = 20000;
+    uint16_t compressedSize = 0;
+    double start = wallMicros();
+    for (int run = 0; run < runs; run++)
+    {
+        uint16_t position = 0;
+        compressedSize = 0;
+        while (position < length)
+            compressedSize += externalEEPROMLzCompress(data, length, position, compressed + compressedSize,
+                                                       sizeof(compressed) - compressedSize);
+    }
+    double compressTime = (wallMicros() - start) / runs;
+    start = wallMicros();
+    for (int run = 0; run < runs; run++)
+    {
+        struct_lzDecoder decoder;
+        externalEEPROMLzBegin(decoder);
+        externalEEPROMLzDecompress(decoder, compressed, compressedSize, readBack, length);
+    }
+    double decompressTime = (wallMicros() - start) / runs;
+
+    printf("%s, %u bytes:\n", name, length);
+    printf("  stored bytes   %5lu plain, %5lu compressed\n", (unsigned long)plainEnd,
+           (unsigned long)(compressedEnd - 1024));
+    printf("  page writes    %5lu plain, %5lu compressed\n", (unsigned long)plain.pageWrites,
+           (unsigned long)packed.pageWrites);
+    printf("  write time     %5luus plain, %5luus compressed\n", plainWrite, compressedWrite);
+    printf("  bus bytes      %5lu plain, %5lu compressed\n",
+           (unsigned long)(plain.bytesToDevice + plain.bytesFromDevice),
+           (unsigned long)(packed.bytesToDevice + packed.bytesFromDevice));
+    printf("  codec CPU      %.1fus to compress, %.2fus to decompress\n", compressTime, decompressTime);
+}
+
+int main()
+{
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    sim.setBusClock(400000);
+    sim.setWriteTimeUs(5000);
+    myMem.setMemoryType(512);
+    myMem.begin(0x50, sim);
+
+    // Two periods of a sine wave
+    for (int x = 0; x < 256; x++)
+        sineTable[x] = 128 + 127 * sin(x * 2 * M_PI / 128);
+
+    compare("Sine table", sineTable, sizeof(sineTable));
+    compare("Menu text", (uint8_t *)menuText, strlen(menuText));
+    return (0);
+}
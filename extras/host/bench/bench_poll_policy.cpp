@@ -0,0 +1,77 @@
+// Busy NACKs during a 4kB write and read back with tWR = 3.3ms, for each backoff mode, and the time
+// it takes to give up on a device that has gone
+
+#include <stdio.h>
+
+#include "SparkFun_External_EEPROM.h"
+#include "SparkFun_External_EEPROM_Simulator.h"
+
+static uint8_t memory[65536], data[4096], readBack[4096];
+
+// A part that stops answering when dead is set
+class FlakyEEPROM : public SimulatedEEPROM
+{
+  public:
+    bool dead = false;
+
+    uint8_t endTransmission(bool sendStop = true) override
+    {
+        uint8_t result = SimulatedEEPROM::endTransmission(sendStop);
+        if (dead)
+            return (2);
+        return (result);
+    }
+};
+
+static void run(const char *name, uint8_t backoff, bool adaptive)
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    sim.setWriteTimeUs(3300);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    myMem.begin(0x50, sim);
+
+    struct_pollPolicy policy = myMem.getPollPolicy();
+    policy.backoff = backoff;
+    if (backoff == EXTERNAL_EEPROM_BACKOFF_FIXED)
+        policy.maxInterval_us = policy.interval_us;
+    myMem.setPollPolicy(policy);
+    if (adaptive == false)
+        myMem.disableAdaptiveWriteTime();
+
+    for (uint32_t x = 0; x < sizeof(data); x++)
+        data[x] = rand();
+    myMem.resetStats();
+    unsigned long startTime = micros();
+    myMem.write(0, data, sizeof(data));
+    myMem.read(0, readBack, sizeof(readBack));
+    unsigned long elapsed = micros() - startTime;
+
+    struct_eepromStats stats;
+    myMem.getStats(stats);
+    printf("  %-28s %6luus, %4lu transfers, %4lu NACKs\n", name, elapsed, (unsigned long)stats.transactions,
+           (unsigned long)stats.nacks);
+}
+
+int main()
+{
+    printf("4kB write and read back:\n");
+    run("fixed 100us", EXTERNAL_EEPROM_BACKOFF_FIXED, false);
+    run("stepped", EXTERNAL_EEPROM_BACKOFF_STEPPED, false);
+    run("exponential", EXTERNAL_EEPROM_BACKOFF_EXPONENTIAL, false);
+    run("exponential + learned tWR", EXTERNAL_EEPROM_BACKOFF_EXPONENTIAL, true);
+
+    FlakyEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    myMem.begin(0x50, sim);
+    sim.dead = true;
+    unsigned long startTime = micros();
+    int result = myMem.write(0, data, sizeof(data));
+    printf("Device gone: write returned %d after %luus\n", result, micros() - startTime);
+    return (0);
+}
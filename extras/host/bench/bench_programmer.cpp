@@ -0,0 +1,60 @@
+// Programming a 128kB image into a 24xx1026 at 400kHz from a ~500kB/s source: a page at a time with
+// write(), then with ExternalEEPROMProgrammer, then a re-flash with 20 bytes changed
+
+#include <stdio.h>
+
+#include "SparkFun_External_EEPROM.h"
+#include "SparkFun_External_EEPROM_Programmer.h"
+#include "SparkFun_External_EEPROM_Simulator.h"
+
+static uint8_t memory[131072], image[131072];
+static uint32_t sourcePosition = 0;
+
+static uint16_t readSource(uint8_t *buffer, uint16_t length)
+{
+    delayMicroseconds(length * 2); // An SD card at about 500kB/s
+    memcpy(buffer, image + sourcePosition, length);
+    sourcePosition += length;
+    return (length);
+}
+
+int main()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 1026);
+    sim.setTimeSource(micros);
+    sim.setBusClock(400000);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(1026);
+    myMem.begin(0x50, sim);
+    for (uint32_t x = 0; x < sizeof(image); x++)
+        image[x] = rand();
+
+    unsigned long startTime = millis();
+    sourcePosition = 0;
+    uint8_t page[128];
+    for (uint32_t location = 0; location < sizeof(image); location += sizeof(page))
+    {
+        readSource(page, sizeof(page));
+        myMem.write(location, page, sizeof(page));
+    }
+    printf("write() a page at a time: %lums\n", millis() - startTime);
+
+    memset(memory, 0xFF, sizeof(memory));
+    ExternalEEPROMProgrammer programmer;
+    programmer.begin(myMem);
+    sourcePosition = 0;
+    programmer.program(0, readSource, sizeof(image));
+    struct_programmerStats stats = programmer.getStats();
+    printf("Programmer, blank part: %lums, %lu pages written, %lu skipped\n", (unsigned long)stats.elapsed_ms,
+           (unsigned long)stats.pagesWritten, (unsigned long)stats.pagesSkipped);
+
+    for (int x = 0; x < 20; x++)
+        image[rand() % sizeof(image)] ^= 0x55;
+    sourcePosition = 0;
+    programmer.program(0, readSource, sizeof(image));
+    stats = programmer.getStats();
+    printf("Programmer, 20 bytes changed: %lums, %lu pages written, %lu skipped\n", (unsigned long)stats.elapsed_ms,
+           (unsigned long)stats.pagesWritten, (unsigned long)stats.pagesSkipped);
+    return (0);
+}
@@ -0,0 +1,36 @@
+// 5000 single byte writes and reads through ExternalEEPROMStream on a 24xx256
+
+#include <stdio.h>
+
+#include "SparkFun_External_EEPROM_Simulator.h"
+#include "SparkFun_External_EEPROM_Stream.h"
+
+static uint8_t memory[32768];
+
+int main()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 256);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(256);
+    myMem.begin(0x50, sim);
+    ExternalEEPROMStream stream;
+    stream.begin(myMem, 1000, 10000);
+
+    sim.resetStats();
+    for (int x = 0; x < 5000; x++)
+        stream.write((uint8_t)(x * 7));
+    stream.flush();
+    struct_simulatedEEPROMStats stats = sim.getStats();
+    printf("5000 byte writes: %lu page writes, %lu transactions\n", (unsigned long)stats.pageWrites,
+           (unsigned long)stats.transactions);
+
+    delay(10);
+    stream.seek(0);
+    sim.resetStats();
+    for (int x = 0; x < 5000; x++)
+        stream.read();
+    printf("5000 byte reads: %lu transactions\n", (unsigned long)sim.getStats().transactions);
+    return (0);
+}
@@ -0,0 +1,59 @@
+// 4kB write to a 24xx512 with tWR = 3.3ms: bus transfers with a fixed 100us poll against the learned
+// write time, then how the estimate follows tWR as it changes
+
+#include <stdio.h>
+
+#include "SparkFun_External_EEPROM.h"
+#include "SparkFun_External_EEPROM_Simulator.h"
+
+static uint8_t memory[65536], data[4096];
+
+static void writeAll(ExternalEEPROM &myMem, SimulatedEEPROM &sim, uint32_t writeTime_us)
+{
+    sim.setWriteTimeUs(writeTime_us);
+    for (uint32_t x = 0; x < sizeof(data); x++)
+        data[x] = rand();
+
+    myMem.resetStats();
+    unsigned long startTime = micros();
+    myMem.write(0, data, sizeof(data));
+    unsigned long elapsed = micros() - startTime;
+
+    struct_eepromStats stats;
+    myMem.getStats(stats);
+    printf("  tWR %4luus: %6luus, %4lu transfers, %4lu NACKs, mean %4luus, holdoff %4luus\n",
+           (unsigned long)writeTime_us, elapsed, (unsigned long)stats.transactions, (unsigned long)stats.nacks,
+           (unsigned long)myMem.getWriteTimeMeanUs(), (unsigned long)myMem.getWriteHoldoffUs());
+}
+
+int main()
+{
+    for (int adaptive = 0; adaptive < 2; adaptive++)
+    {
+        SimulatedEEPROM sim;
+        sim.begin(memory, 512);
+        sim.setTimeSource(micros);
+        ExternalEEPROM myMem;
+        myMem.setMemoryType(512);
+        myMem.begin(0x50, sim);
+
+        if (adaptive == 0)
+        {
+            // The poll loop before the poll policy: every 100us until the device answers
+            struct_pollPolicy policy = myMem.getPollPolicy();
+            policy.backoff = EXTERNAL_EEPROM_BACKOFF_FIXED;
+            policy.maxInterval_us = policy.interval_us;
+            myMem.setPollPolicy(policy);
+            myMem.disableAdaptiveWriteTime();
+            printf("Fixed 100us poll:\n");
+            writeAll(myMem, sim, 3300);
+            continue;
+        }
+
+        printf("Learned write time:\n");
+        uint32_t writeTimes[] = {3300, 3300, 2000, 2000, 4500, 4500};
+        for (uint32_t writeTime_us : writeTimes)
+            writeAll(myMem, sim, writeTime_us);
+    }
+    return (0);
+}
@@ -0,0 +1,6 @@
+#include "Arduino.h"
+#include "Wire.h"
+
+uint32_t hostMicros = 0;
+
+TwoWire Wire;
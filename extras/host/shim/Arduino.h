@@ -0,0 +1,203 @@
+/*
+  Minimal Arduino core for building the SparkFun External EEPROM library on a host.
+
+  Only what the library and the host tests use is provided. Time is virtual:
+  micros() returns hostMicros, and delay()/delayMicroseconds() advance it instead
+  of sleeping. Runs are deterministic and a 5ms write cycle costs no wall time.
+  Anything that waits on micros() must therefore delay (or yield) inside its loop;
+  a bare while(isBusy()); never finishes on the host.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#ifndef _HOST_ARDUINO_H
+#define _HOST_ARDUINO_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define INPUT 0
+#define OUTPUT 1
+#define LOW 0
+#define HIGH 1
+#define F(string) string
+
+extern uint32_t hostMicros; // Virtual time in us, advanced by delay() and delayMicroseconds()
+
+inline unsigned long micros()
+{
+    return (hostMicros);
+}
+inline unsigned long millis()
+{
+    return (hostMicros / 1000);
+}
+inline void delay(unsigned long ms)
+{
+    hostMicros += ms * 1000;
+}
+inline void delayMicroseconds(unsigned int us)
+{
+    hostMicros += us;
+}
+inline void yield()
+{
+}
+
+inline long random(long low, long high)
+{
+    return (low + rand() % (high - low));
+}
+inline void pinMode(uint8_t, uint8_t)
+{
+}
+inline void digitalWrite(uint8_t, uint8_t)
+{
+}
+
+template <class T> inline T min(T a, T b)
+{
+    return (a < b ? a : b);
+}
+
+// Just enough of String for getString()/putString()
+class String
+{
+  public:
+    String()
+    {
+    }
+    String(const char *text) : value(text ? text : "")
+    {
+    }
+
+    unsigned int length() const
+    {
+        return (value.size());
+    }
+    const char *c_str() const
+    {
+        return (value.c_str());
+    }
+    bool reserve(unsigned int size)
+    {
+        value.reserve(size);
+        return (true);
+    }
+    bool concat(const char *text, unsigned int length)
+    {
+        value.append(text, length);
+        return (true);
+    }
+    void remove(unsigned int index, unsigned int count)
+    {
+        value.erase(index, count);
+    }
+    String &operator+=(char c)
+    {
+        value += c;
+        return (*this);
+    }
+    String &operator+=(const char *text)
+    {
+        value += text;
+        return (*this);
+    }
+    bool operator==(const char *text) const
+    {
+        return (value == text);
+    }
+    bool operator==(const String &other) const
+    {
+        return (value == other.value);
+    }
+    char operator[](unsigned int index) const
+    {
+        return (value[index]);
+    }
+
+  private:
+    std::string value;
+};
+
+class Print
+{
+  public:
+    virtual ~Print()
+    {
+    }
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+        size_t written = 0;
+        while (size--)
+            written += write(*buffer++);
+        return (written);
+    }
+    size_t write(const char *text)
+    {
+        return (write((const uint8_t *)text, strlen(text)));
+    }
+    virtual int availableForWrite()
+    {
+        return (0);
+    }
+    virtual void flush()
+    {
+    }
+
+    size_t print(const char *text)
+    {
+        return (write(text));
+    }
+    size_t print(unsigned long value)
+    {
+        return (write(std::to_string(value).c_str()));
+    }
+    size_t println(const char *text)
+    {
+        return (print(text) + write("\r\n"));
+    }
+    size_t println(unsigned long value)
+    {
+        return (print(value) + write("\r\n"));
+    }
+};
+
+class Stream : public Print
+{
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual size_t readBytes(uint8_t *buffer, size_t length)
+    {
+        size_t count = 0;
+        while (count < length)
+        {
+            int c = read();
+            if (c < 0)
+                break;
+            buffer[count++] = c;
+        }
+        return (count);
+    }
+    size_t readBytes(char *buffer, size_t length)
+    {
+        return (readBytes((uint8_t *)buffer, length));
+    }
+};
+
+#endif //_HOST_ARDUINO_H
@@ -0,0 +1,57 @@
+/*
+  Stand-in TwoWire for host builds. There is no bus: every transaction NACKs.
+  Tests talk to a SimulatedEEPROM through begin(address, transport) instead.
+*/
+
+#ifndef _HOST_WIRE_H
+#define _HOST_WIRE_H
+
+#include "Arduino.h"
+
+#define BUFFER_LENGTH 32
+
+class TwoWire
+{
+  public:
+    void begin()
+    {
+    }
+    void setClock(uint32_t)
+    {
+    }
+    void beginTransmission(uint8_t)
+    {
+    }
+    size_t write(uint8_t)
+    {
+        return (1);
+    }
+    size_t write(const uint8_t *, size_t length)
+    {
+        return (length);
+    }
+    uint8_t endTransmission(bool = true)
+    {
+        return (2); // Address NACK
+    }
+    uint8_t requestFrom(uint8_t, size_t, bool = true)
+    {
+        return (0);
+    }
+    uint8_t requestFrom(uint8_t, uint8_t)
+    {
+        return (0);
+    }
+    int available()
+    {
+        return (0);
+    }
+    int read()
+    {
+        return (-1);
+    }
+};
+
+extern TwoWire Wire;
+
+#endif //_HOST_WIRE_H
@@ -0,0 +1,41 @@
+/*
+  Shared by the host tests. CHECK() stays active in optimized builds and reports
+  the failing line, then exits so make test stops.
+*/
+
+#ifndef _HOST_TEST_H
+#define _HOST_TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SparkFun_External_EEPROM.h"
+#include "SparkFun_External_EEPROM_Simulator.h"
+
+#define CHECK(condition)                                                                                               \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(condition))                                                                                              \
+        {                                                                                                              \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);                                       \
+            exit(1);                                                                                                   \
+        }                                                                                                              \
+    } while (0)
+
+// A simulated part whose endTransmission() fails while dead is set, as if the device left the bus
+class FlakyEEPROM : public SimulatedEEPROM
+{
+  public:
+    bool dead = false;
+
+    uint8_t endTransmission(bool sendStop = true) override
+    {
+        uint8_t result = SimulatedEEPROM::endTransmission(sendStop);
+        if (dead)
+            return (2); // Address NACK
+        return (result);
+    }
+};
+
+#endif //_HOST_TEST_H
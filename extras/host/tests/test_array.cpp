@@ -0,0 +1,90 @@
+// ExternalEEPROMArray: concatenated and striped devices
+
+#include "HostTest.h"
+#include "SparkFun_External_EEPROM_Array.h"
+
+#define MAX_CHIPS 4
+
+// Routes each transaction to the simulated part at its address
+class SharedBus : public ExternalEEPROMTransport
+{
+  public:
+    SimulatedEEPROM *parts[MAX_CHIPS];
+
+    void beginTransmission(uint8_t i2cAddress)
+    {
+        current = parts[i2cAddress - 0x50];
+        current->beginTransmission(i2cAddress);
+    }
+    size_t write(uint8_t dataToWrite)
+    {
+        return (current->write(dataToWrite));
+    }
+    uint8_t endTransmission(bool sendStop = true)
+    {
+        return (current->endTransmission(sendStop));
+    }
+    size_t requestFrom(uint8_t i2cAddress, size_t length)
+    {
+        current = parts[i2cAddress - 0x50];
+        return (current->requestFrom(i2cAddress, length));
+    }
+    int read()
+    {
+        return (current->read());
+    }
+
+  private:
+    SimulatedEEPROM *current = nullptr;
+};
+
+static uint8_t memory[MAX_CHIPS][65536];
+static uint8_t image[16384], readBack[16384];
+
+static void check(int chips, uint32_t stripeSize)
+{
+    SimulatedEEPROM sims[MAX_CHIPS];
+    ExternalEEPROM devices[MAX_CHIPS];
+    SharedBus bus;
+    ExternalEEPROMArray array;
+    for (int x = 0; x < chips; x++)
+    {
+        sims[x].begin(memory[x], 65536, 128, 2, 0x50 + x);
+        sims[x].setTimeSource(micros);
+        bus.parts[x] = &sims[x];
+        devices[x].setMemoryType(512);
+        CHECK(devices[x].begin(0x50 + x, bus));
+        CHECK(array.addDevice(devices[x]));
+    }
+    array.setStripeSize(stripeSize);
+    CHECK(array.length() == (uint32_t)chips * 65536);
+
+    uint32_t location = 1000;
+    if (chips > 1)
+        location = 60000; // Runs onto the second device when concatenated
+    array.write(location, image, sizeof(image));
+    memset(readBack, 0, sizeof(readBack));
+    array.read(location, readBack, sizeof(readBack));
+    CHECK(memcmp(image, readBack, sizeof(image)) == 0);
+
+    if (chips > 1 && stripeSize == 0) // The second device starts where the first ends
+        CHECK(memory[1][0] == image[65536 - location]);
+
+    uint32_t value = 0xDEADBEEF, readValue;
+    array.put(65530, value); // Spans two devices when concatenated
+    array.get(65530, readValue);
+    CHECK(readValue == value);
+}
+
+int main()
+{
+    for (uint32_t x = 0; x < sizeof(image); x++)
+        image[x] = rand();
+    for (int chips = 1; chips <= MAX_CHIPS; chips *= 2)
+    {
+        check(chips, 0);
+        check(chips, 128);
+    }
+    printf("ok\n");
+    return (0);
+}
@@ -0,0 +1,116 @@
+// writeAsync(): queueing, read overlay, ring wrap, and coherence with the read and write caches
+
+#include "HostTest.h"
+
+static uint8_t memory[65536];
+static int callbacks = 0;
+
+static void asyncDone(uint32_t, uint16_t, int)
+{
+    callbacks++;
+}
+
+static void testQueue()
+{
+    memset(memory, 0, sizeof(memory));
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+    CHECK(myMem.enableAsyncWrite(600));
+    myMem.setAsyncWriteCallback(asyncDone);
+
+    uint8_t first[300], second[100];
+    for (int x = 0; x < 300; x++)
+        first[x] = x;
+    for (int x = 0; x < 100; x++)
+        second[x] = 200 + x;
+    CHECK(myMem.writeAsync(10, first, 300));
+    CHECK(myMem.writeAsync(50, second, 100)); // Overlaps the first
+    CHECK(myMem.writeAsync(0, first, 300) == false); // Queue full
+
+    // Reads see the queued data in order
+    uint8_t readBack[400];
+    myMem.read(0, readBack, 400);
+    for (int x = 0; x < 300; x++)
+        if (x + 10 < 50 || x + 10 >= 150)
+            CHECK(readBack[10 + x] == first[x]);
+    CHECK(memcmp(readBack + 50, second, 100) == 0);
+
+    while (myMem.isAsyncWriteComplete() == false)
+    {
+        myMem.update();
+        delayMicroseconds(500);
+    }
+    CHECK(callbacks == 2);
+    CHECK(memcmp(memory + 50, second, 100) == 0);
+    CHECK(memcmp(memory + 10, first, 40) == 0);
+
+    // Wrap the ring several times
+    for (int x = 0; x < 20; x++)
+        while (myMem.writeAsync(1000 + x * 37, first, 37) == false)
+        {
+            myMem.update();
+            delayMicroseconds(300);
+        }
+    myMem.write(5000, 7); // Synchronous writes drain the queue first
+    CHECK(myMem.waitForAsyncWrites());
+    for (int x = 0; x < 20; x++)
+        CHECK(memcmp(memory + 1000 + x * 37, first, 37) == 0);
+    myMem.disableAsyncWrite();
+}
+
+static void testReadCacheFill()
+{
+    memset(memory, 0, sizeof(memory));
+    SimulatedEEPROM sim;
+    sim.begin(memory, 256);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(256);
+    CHECK(myMem.begin(0x50, sim));
+    CHECK(myMem.enableReadCache(4));
+    CHECK(myMem.enableAsyncWrite(256));
+
+    uint8_t data[4] = {1, 2, 3, 4}, readBack[4];
+    myMem.writeAsync(10, data, 4);
+    myMem.read(0, readBack, 2); // Loads the block holding 10 while it is still queued
+    CHECK(myMem.waitForAsyncWrites());
+    myMem.read(10, readBack, 4);
+    CHECK(memcmp(data, readBack, 4) == 0);
+    CHECK(memcmp(memory + 10, data, 4) == 0);
+}
+
+static void testWriteCacheFill()
+{
+    memset(memory, 0, sizeof(memory));
+    SimulatedEEPROM sim;
+    sim.begin(memory, 256);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(256);
+    CHECK(myMem.begin(0x50, sim));
+    CHECK(myMem.enableWriteCache(2));
+    CHECK(myMem.enableAsyncWrite(256));
+
+    uint8_t data[4] = {5, 6, 7, 8}, readBack[4], other[2] = {9, 9};
+    myMem.writeAsync(100, data, 4);
+    myMem.write(96, other, 2); // Allocates the line holding 100 while it is still queued
+    myMem.read(100, readBack, 4);
+    CHECK(memcmp(data, readBack, 4) == 0);
+    myMem.flush();
+    CHECK(myMem.waitForAsyncWrites());
+    CHECK(memcmp(memory + 100, data, 4) == 0);
+    CHECK(memory[96] == 9);
+}
+
+int main()
+{
+    testQueue();
+    testReadCacheFill();
+    testWriteCacheFill();
+    printf("ok\n");
+    return (0);
+}
@@ -0,0 +1,48 @@
+// CRC kernels, and crc32()/crc16()/verify() over device memory
+
+#include "HostTest.h"
+
+static uint8_t memory[131072];
+static uint8_t image[3000];
+
+static void testKernels()
+{
+    const uint8_t *check = (const uint8_t *)"123456789";
+    CHECK(externalEEPROMCrc32(0, check, 9) == 0xCBF43926);
+    CHECK(externalEEPROMCrc16(0xFFFF, check, 9) == 0x29B1);
+
+    uint8_t data[1003];
+    for (int x = 0; x < 1003; x++)
+        data[x] = x * 7;
+    CHECK(externalEEPROMCrc32(externalEEPROMCrc32(0, data, 501), data + 501, 502) == externalEEPROMCrc32(0, data, 1003));
+}
+
+static void testDevice()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 1025);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(1025);
+    CHECK(myMem.begin(0x50, sim));
+
+    for (int x = 0; x < 3000; x++)
+        image[x] = x * 13 + 5;
+    myMem.write(65536 - 1000, image, 3000); // Crosses the block boundary
+    CHECK(myMem.crc32(65536 - 1000, 3000) == externalEEPROMCrc32(0, image, 3000));
+    CHECK(myMem.crc16(65536 - 1000, 3000) == externalEEPROMCrc16(0xFFFF, image, 3000));
+    CHECK(myMem.verify(65536 - 1000, image, 3000));
+
+    image[40] ^= 1;
+    sim.resetStats();
+    CHECK(myMem.verify(65536 - 1000, image, 3000) == false);
+    CHECK(sim.getStats().transactions <= 4); // Stops at the first burst that differs
+}
+
+int main()
+{
+    testKernels();
+    testDevice();
+    printf("ok\n");
+    return (0);
+}
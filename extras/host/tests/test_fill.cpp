@@ -0,0 +1,32 @@
+// erase() and fill() skip pages that already hold the value
+
+#include "HostTest.h"
+
+static uint8_t memory[65536];
+
+int main()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+
+    myMem.erase(0xFF); // Already blank
+    CHECK(myMem.getFillPageWrites() == 0);
+    CHECK(myMem.getFillPagesSkipped() == 512);
+
+    memory[1000] = 1;
+    memory[40000] = 2;
+    myMem.erase(0xFF);
+    CHECK(myMem.getFillPageWrites() == 2);
+    for (uint32_t x = 0; x < sizeof(memory); x++)
+        CHECK(memory[x] == 0xFF);
+
+    myMem.fill(10, 300, 0x42);
+    for (uint32_t x = 0; x < sizeof(memory); x++)
+        CHECK(memory[x] == ((x >= 10 && x < 310) ? 0x42 : 0xFF));
+    printf("ok\n");
+    return (0);
+}
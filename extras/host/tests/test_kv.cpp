@@ -0,0 +1,123 @@
+// ExternalEEPROMKV against a reference map, with reopening, compaction, power loss and hash collisions
+
+#include "HostTest.h"
+#include "SparkFun_External_EEPROM_KV.h"
+
+#include <map>
+#include <string>
+
+static uint8_t memory[65536];
+
+static void checkAll(ExternalEEPROMKV &kv, std::map<std::string, uint32_t> &reference)
+{
+    for (auto &entry : reference)
+    {
+        uint32_t value;
+        CHECK(kv.get(entry.first.c_str(), value));
+        CHECK(value == entry.second);
+    }
+    CHECK(kv.getKeyCount() == reference.size());
+}
+
+static void testRandomOps()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+    for (uint32_t x = 0; x < sizeof(memory); x++)
+        memory[x] = rand();
+
+    ExternalEEPROMKV kv;
+    CHECK(kv.begin(myMem, 4096, 8192, 100));
+    CHECK(kv.getKeyCount() == 0);
+
+    std::map<std::string, uint32_t> reference;
+    char key[20];
+    for (int x = 0; x < 5000; x++)
+    {
+        snprintf(key, sizeof(key), "param.%d", rand() % 80);
+        if (rand() % 10 == 0)
+        {
+            CHECK(kv.remove(key) == (reference.count(key) > 0));
+            reference.erase(key);
+        }
+        else
+        {
+            uint32_t value = rand();
+            CHECK(kv.put(key, value));
+            reference[key] = value;
+        }
+        if (x % 3 == 0)
+            kv.update();
+        if (x % 997 == 0)
+        {
+            kv.end();
+            CHECK(kv.begin(myMem, 4096, 8192, 100));
+        }
+        if (x % 500 == 0)
+            checkAll(kv, reference);
+    }
+    checkAll(kv, reference);
+    kv.compact();
+    checkAll(kv, reference);
+
+    // Abandon a store part way through a background compaction, as at power loss
+    {
+        ExternalEEPROMKV interrupted;
+        CHECK(interrupted.begin(myMem, 4096, 8192, 100));
+        uint32_t count = 0;
+        while (interrupted.isCompacting() == false && count < 10000)
+        {
+            interrupted.put("spin", count);
+            count++;
+        }
+        for (int x = 0; x < 70; x++)
+            interrupted.update();
+        CHECK(interrupted.isCompacting());
+        reference["spin"] = count - 1;
+        interrupted.put("late", (uint32_t)77);
+        reference["late"] = 77;
+    }
+
+    ExternalEEPROMKV resumed;
+    CHECK(resumed.begin(myMem, 4096, 8192, 100));
+    checkAll(resumed, reference);
+    resumed.compact();
+    checkAll(resumed, reference);
+}
+
+// "glbvs" and "yacxa" have the same hash and length
+static void testCollision()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 256);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(256);
+    CHECK(myMem.begin(0x50, sim));
+
+    ExternalEEPROMKV kv;
+    CHECK(kv.begin(myMem, 4096, 8192, 100));
+    uint32_t value = 1234, readBack = 0;
+    CHECK(kv.put("glbvs", value));
+    CHECK(kv.get("glbvs", readBack) && readBack == 1234);
+    CHECK(kv.get("yacxa", readBack) == false);
+    CHECK(kv.exists("yacxa") == false);
+    CHECK(kv.getValueLength("yacxa") == 0);
+    CHECK(kv.remove("yacxa") == false);
+    CHECK(kv.exists("glbvs"));
+
+    ExternalEEPROMKV tooBig;
+    CHECK(tooBig.begin(myMem, 4096, 8192, 60000) == false);
+}
+
+int main()
+{
+    testRandomOps();
+    testCollision();
+    printf("ok\n");
+    return (0);
+}
@@ -0,0 +1,101 @@
+// ExternalEEPROMLog: appends, reopening, wrap, and erased memory
+
+#include "HostTest.h"
+#include "SparkFun_External_EEPROM_Log.h"
+
+static uint8_t memory[65536];
+
+struct Sample
+{
+    uint32_t time;
+    float value;
+    uint8_t id;
+} __attribute__((packed));
+
+static void testAppendAndWrap()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+    for (uint32_t x = 0; x < sizeof(memory); x++)
+        memory[x] = rand();
+
+    ExternalEEPROMLog log;
+    CHECK(log.begin(myMem, 1000, 2048, sizeof(Sample)));
+    log.format();
+    CHECK(log.getRecordCount() == 0);
+
+    for (uint32_t x = 0; x < 100; x++)
+    {
+        Sample sample = {x, x * 0.5f, (uint8_t)x};
+        CHECK(log.put(sample));
+    }
+    Sample sample;
+    CHECK(log.get(0, sample) && sample.time == 0);
+    CHECK(log.get(99, sample) && sample.time == 99);
+    log.sync();
+
+    ExternalEEPROMLog reopened;
+    CHECK(reopened.begin(myMem, 1000, 2048, sizeof(Sample)));
+    CHECK(reopened.getRecordCount() == 100);
+    CHECK(reopened.getSequence() == 100);
+    for (uint32_t x = 100; x < 1000; x++)
+    {
+        Sample next = {x, x * 0.5f, (uint8_t)x};
+        CHECK(reopened.put(next));
+    }
+    reopened.end();
+
+    ExternalEEPROMLog wrapped;
+    CHECK(wrapped.begin(myMem, 1000, 2048, sizeof(Sample)));
+    CHECK(wrapped.getSequence() == 1000);
+    uint32_t count = wrapped.getRecordCount();
+    CHECK(count < 1000 && count <= wrapped.getCapacity());
+    CHECK(wrapped.get(count - 1, sample) && sample.time == 999);
+    CHECK(wrapped.get(0, sample) && sample.time == 1000 - count);
+}
+
+// Erased entries must never pass the CRC, whatever the record size
+static void testErased()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+
+    uint16_t recordSizes[] = {122, 100, 20}; // 122 is the largest that fits a 128 byte page
+    for (uint16_t recordSize : recordSizes)
+    {
+        memset(memory, 0xFF, sizeof(memory));
+        ExternalEEPROMLog log;
+        CHECK(log.begin(myMem, 0, 4096, recordSize));
+        CHECK(log.getRecordCount() == 0);
+        CHECK(log.getSequence() == 0);
+
+        uint8_t record[256];
+        for (int x = 0; x < 5; x++)
+        {
+            memset(record, x, recordSize);
+            CHECK(log.append(record));
+        }
+        log.sync();
+
+        ExternalEEPROMLog reopened;
+        CHECK(reopened.begin(myMem, 0, 4096, recordSize));
+        CHECK(reopened.getRecordCount() == 5);
+        CHECK(reopened.getSequence() == 5);
+    }
+}
+
+int main()
+{
+    testAppendAndWrap();
+    testErased();
+    printf("ok\n");
+    return (0);
+}
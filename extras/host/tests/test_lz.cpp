@@ -0,0 +1,110 @@
+// LZ codec round trips, fed in pieces, and putCompressed()/getCompressed() on a device
+
+#include "HostTest.h"
+
+#include <math.h>
+
+static uint8_t memory[32768];
+static uint8_t input[20000], output[20000], compressed[40000];
+
+static void fillInput(int kind, uint32_t length)
+{
+    for (uint32_t x = 0; x < length; x++)
+    {
+        switch (kind)
+        {
+        case 0: // Random
+            input[x] = rand();
+            break;
+        case 1: // Zeros
+            input[x] = 0;
+            break;
+        case 2: // Text
+            input[x] = "the quick brown fox "[x % 20];
+            break;
+        case 3: // Table
+            input[x] = (uint8_t)(128 + 127 * sin(x / 20.0));
+            break;
+        default: // Runs
+            input[x] = (rand() % 4) ? input[x > 0 ? x - 1 : 0] : rand();
+            break;
+        }
+    }
+}
+
+static void testCodec()
+{
+    uint32_t lengths[] = {0, 1, 2, 3, 5, 127, 128, 129, 300, 1000, 20000};
+    for (int kind = 0; kind < 5; kind++)
+        for (uint32_t length : lengths)
+        {
+            fillInput(kind, length);
+
+            // Compress into uneven output pieces
+            uint16_t position = 0;
+            uint32_t compressedLength = 0;
+            while (position < length)
+                compressedLength += externalEEPROMLzCompress(input, length, position, compressed + compressedLength,
+                                                             7 + (compressedLength % 50));
+
+            // Decompress in 13 byte pieces
+            struct_lzDecoder decoder;
+            externalEEPROMLzBegin(decoder);
+            memset(output, 0xAA, sizeof(output));
+            for (uint32_t x = 0; x < compressedLength; x += 13)
+            {
+                uint32_t piece = compressedLength - x < 13 ? compressedLength - x : 13;
+                CHECK(externalEEPROMLzDecompress(decoder, compressed + x, piece, output, length));
+            }
+            CHECK(decoder.produced == length);
+            CHECK(memcmp(input, output, length) == 0);
+        }
+}
+
+static void testDevice()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 256);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(256);
+    CHECK(myMem.begin(0x50, sim));
+
+    const char *text = "SparkFun External EEPROM. Lookup tables and text compress well. ";
+    uint32_t locations[] = {0, 7, 1000, 32767 - 200};
+    for (uint32_t location : locations)
+    {
+        uint16_t length = 2000;
+        if (location > 30000)
+            length = 150; // Ends at the last byte of the part
+        for (int x = 0; x < length; x++)
+            input[x] = text[x % strlen(text)] ^ (rand() % 50 == 0);
+
+        uint32_t next = myMem.putCompressed(location, input, length);
+        CHECK(next > location && next - location < length);
+        CHECK(myMem.getCompressedLength(location) == length);
+        memset(output, 0, length);
+        CHECK(myMem.getCompressed(location, output, length) == length);
+        CHECK(memcmp(input, output, length) == 0);
+
+        // A short buffer gets the start and is not overrun
+        memset(output, 0x55, length);
+        CHECK(myMem.getCompressed(location, output, 100) == length);
+        CHECK(memcmp(input, output, 100) == 0);
+        CHECK(output[100] == 0x55);
+    }
+
+    // Corrupt stream: a match before any output
+    uint16_t length = 10;
+    myMem.write(5000, (uint8_t *)&length, 2);
+    myMem.write(5002, 0xFF);
+    CHECK(myMem.getCompressed(5000, output, 10) == 0);
+}
+
+int main()
+{
+    testCodec();
+    testDevice();
+    printf("ok\n");
+    return (0);
+}
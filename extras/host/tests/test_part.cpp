@@ -0,0 +1,80 @@
+// ExternalEEPROMT compile-time part profiles, checked against the runtime class, and the bounded poll
+
+#include "HostTest.h"
+#include "SparkFun_External_EEPROM_Part.h"
+
+static uint8_t memory[262144], image[5000], readBack[5000];
+
+template <class PART> static void check(uint16_t type, uint32_t location, uint16_t length)
+{
+    SimulatedEEPROM sim;
+    CHECK(sim.begin(memory, type));
+    sim.setTimeSource(micros);
+    ExternalEEPROMT<PART> myMem;
+    CHECK(myMem.begin(0x50, sim));
+
+    CHECK(myMem.write(location, image, length) == 0);
+    memset(readBack, 0, length);
+    CHECK(myMem.read(location, readBack, length) == 0);
+    CHECK(memcmp(image, readBack, length) == 0);
+
+    // The runtime class reads back the same layout
+    ExternalEEPROM runtime;
+    runtime.setMemoryType(type);
+    CHECK(runtime.begin(0x50, sim));
+    memset(readBack, 0, length);
+    runtime.read(location, readBack, length);
+    CHECK(memcmp(image, readBack, length) == 0);
+
+    uint32_t value = 0x12345678, readValue;
+    myMem.put(location + 1, value);
+    myMem.get(location + 1, readValue);
+    CHECK(readValue == value);
+}
+
+static int yields = 0;
+
+static void countYield()
+{
+    yields++;
+    delayMicroseconds(10);
+}
+
+static void testTimeout()
+{
+    FlakyEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROMT<ExternalEEPROMPart::M24512> myMem;
+    CHECK(myMem.begin(0x50, sim));
+
+    uint8_t data[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    CHECK(myMem.write(70000, data, 10) == 0); // Past the end of the part: nothing to do
+
+    sim.dead = true;
+    unsigned long startTime = micros();
+    CHECK(myMem.read(0, readBack, 4) == EXTERNAL_EEPROM_TIMEOUT);
+    CHECK(micros() - startTime < 60000);
+
+    myMem.setPollYield(countYield);
+    CHECK(myMem.write(0, data, 4) == EXTERNAL_EEPROM_TIMEOUT);
+    CHECK(yields > 0);
+}
+
+int main()
+{
+    for (uint32_t x = 0; x < sizeof(image); x++)
+        image[x] = rand();
+    check<ExternalEEPROMPart::M2400>(0, 3, 10);
+    check<ExternalEEPROMPart::M2402>(2, 3, 200);
+    check<ExternalEEPROMPart::M2416>(16, 100, 1900);
+    check<ExternalEEPROMPart::M2432>(32, 100, 3000);
+    check<ExternalEEPROMPart::M24512>(512, 65000, 500);
+    check<ExternalEEPROMPart::M241025>(1025, 65000, 5000);
+    check<ExternalEEPROMPart::M241026>(1026, 65000, 5000);
+    check<ExternalEEPROMPart::M24M02>(2048, 196000, 5000);
+    static_assert(ExternalEEPROMT<ExternalEEPROMPart::M24512>::length() == 65536, "");
+    testTimeout();
+    printf("ok\n");
+    return (0);
+}
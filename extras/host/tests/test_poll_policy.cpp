@@ -0,0 +1,76 @@
+// Poll policy: every backoff mode completes, a vanished device times out, and the yield hook runs
+
+#include "HostTest.h"
+
+static uint8_t memory[65536], data[4096], readBack[4096];
+
+static int yields = 0;
+
+static void countYield()
+{
+    yields++;
+    delayMicroseconds(50);
+}
+
+static void checkBackoff(uint8_t backoff)
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    sim.setWriteTimeUs(3300);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+
+    struct_pollPolicy policy = myMem.getPollPolicy();
+    policy.backoff = backoff;
+    myMem.setPollPolicy(policy);
+    myMem.disableAdaptiveWriteTime();
+
+    for (uint32_t x = 0; x < sizeof(data); x++)
+        data[x] = rand();
+    CHECK(myMem.write(0, data, sizeof(data)) == 0);
+    CHECK(myMem.read(0, readBack, sizeof(readBack)) == 0);
+    CHECK(memcmp(data, readBack, sizeof(data)) == 0);
+}
+
+static void testGone()
+{
+    FlakyEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+
+    sim.dead = true;
+    unsigned long startTime = micros();
+    CHECK(myMem.write(0, data, sizeof(data)) == EXTERNAL_EEPROM_TIMEOUT);
+    CHECK(micros() - startTime < 60000); // Stops at the first page
+    CHECK(myMem.read(0, readBack, 100) == EXTERNAL_EEPROM_TIMEOUT);
+
+    sim.dead = false;
+    myMem.setPollYield(countYield);
+    CHECK(myMem.write(0, data, 256) == 0);
+    myMem.read(0, readBack, 256);
+    CHECK(memcmp(data, readBack, 256) == 0);
+    CHECK(yields > 0);
+
+    // Queued data stays queued through a timeout
+    CHECK(myMem.enableAsyncWrite(512));
+    myMem.writeAsync(0, data, 200);
+    sim.dead = true;
+    CHECK(myMem.waitForAsyncWrites() == false);
+    sim.dead = false;
+    CHECK(myMem.waitForAsyncWrites());
+}
+
+int main()
+{
+    checkBackoff(EXTERNAL_EEPROM_BACKOFF_FIXED);
+    checkBackoff(EXTERNAL_EEPROM_BACKOFF_STEPPED);
+    checkBackoff(EXTERNAL_EEPROM_BACKOFF_EXPONENTIAL);
+    testGone();
+    printf("ok\n");
+    return (0);
+}
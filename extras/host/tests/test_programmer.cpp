@@ -0,0 +1,59 @@
+// ExternalEEPROMProgrammer: full image, re-flash of a few changed bytes, unaligned short image
+
+#include "HostTest.h"
+#include "SparkFun_External_EEPROM_Programmer.h"
+
+static uint8_t memory[131072], image[131072], readBack[131072];
+static uint32_t sourcePosition = 0;
+
+static uint16_t readSource(uint8_t *buffer, uint16_t length)
+{
+    memcpy(buffer, image + sourcePosition, length);
+    sourcePosition += length;
+    return (length);
+}
+
+static void checkImage(ExternalEEPROM &myMem)
+{
+    for (uint32_t location = 0; location < sizeof(readBack); location += 32768)
+        myMem.read(location, readBack + location, 32768);
+    CHECK(memcmp(readBack, image, sizeof(image)) == 0);
+}
+
+int main()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 1026);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(1026);
+    CHECK(myMem.begin(0x50, sim));
+    for (uint32_t x = 0; x < sizeof(image); x++)
+        image[x] = rand();
+
+    ExternalEEPROMProgrammer programmer;
+    CHECK(programmer.begin(myMem));
+    sourcePosition = 0;
+    CHECK(programmer.program(0, readSource, sizeof(image)));
+    struct_programmerStats stats = programmer.getStats();
+    CHECK(stats.pagesWritten == sizeof(image) / 128);
+    CHECK(stats.pagesSkipped == 0);
+    checkImage(myMem);
+
+    for (int x = 0; x < 20; x++)
+        image[rand() % sizeof(image)] ^= 0x55;
+    sourcePosition = 0;
+    CHECK(programmer.program(0, readSource, sizeof(image)));
+    stats = programmer.getStats();
+    CHECK(stats.pagesWritten <= 20);
+    CHECK(stats.pagesWritten + stats.pagesSkipped == sizeof(image) / 128);
+    checkImage(myMem);
+
+    // Unaligned start, shorter than a page at each end
+    sourcePosition = sizeof(image) - 300;
+    CHECK(programmer.program(1000, readSource, 300));
+    myMem.read(1000, readBack, 300);
+    CHECK(memcmp(readBack, image + sizeof(image) - 300, 300) == 0);
+    printf("ok\n");
+    return (0);
+}
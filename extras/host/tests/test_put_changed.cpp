@@ -0,0 +1,42 @@
+// putChanged() only programs the pages whose bytes differ
+
+#include "HostTest.h"
+
+static uint8_t memory[65536];
+
+struct Settings
+{
+    uint8_t values[64];
+};
+
+int main()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+
+    Settings settings;
+    for (int x = 0; x < 64; x++)
+        settings.values[x] = x;
+    myMem.put(100, settings);
+    for (int x = 0; x < 64; x += 3)
+        settings.values[x] ^= 0xFF;
+
+    sim.resetStats();
+    myMem.putChanged(100, settings);
+    CHECK(sim.getStats().pageWrites <= 3); // 100..163 touches at most one page per TX chunk
+    CHECK(memcmp(memory + 100, settings.values, 64) == 0);
+
+    Settings readBack;
+    myMem.get(100, readBack);
+    CHECK(memcmp(&readBack, &settings, sizeof(settings)) == 0);
+
+    sim.resetStats();
+    myMem.putChanged(100, settings); // Nothing changed
+    CHECK(sim.getStats().pageWrites == 0);
+    printf("ok\n");
+    return (0);
+}
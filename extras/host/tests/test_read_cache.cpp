@@ -0,0 +1,81 @@
+// LRU read cache: hits, read-ahead, coherence with writes and failed reads
+
+#include "HostTest.h"
+
+static uint8_t memory[65536];
+
+static void testHits()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+    for (uint32_t x = 0; x < sizeof(memory); x++)
+        memory[x] = x * 13;
+    CHECK(myMem.enableReadCache(4));
+
+    for (int pass = 0; pass < 10; pass++)
+        for (int x = 0; x < 16; x++)
+        {
+            uint32_t value, expected;
+            myMem.get(100 + x * 4, value);
+            memcpy(&expected, memory + 100 + x * 4, 4);
+            CHECK(value == expected);
+        }
+    CHECK(myMem.getReadCacheMisses() <= 2);
+    CHECK(myMem.getReadCacheHits() >= 158);
+
+    // Writes update the cached copy
+    uint32_t value = 0xDEADBEEF, readBack;
+    myMem.put(104, value);
+    myMem.get(104, readBack);
+    CHECK(readBack == value);
+    myMem.erase(0x11);
+    myMem.get(104, readBack);
+    CHECK(readBack == 0x11111111);
+    uint8_t buffer[1000];
+    myMem.read(5, buffer, 1000);
+    for (int x = 0; x < 1000; x++)
+        CHECK(buffer[x] == 0x11);
+
+    // Sequential byte reads are served by read-ahead
+    for (uint32_t x = 0; x < sizeof(memory); x++)
+        memory[x] = x * 13;
+    myMem.invalidateReadCache();
+    myMem.resetReadCacheStats();
+    for (int x = 0; x < 256; x++)
+        CHECK(myMem.read(3000 + x) == (uint8_t)((3000 + x) * 13));
+    CHECK(myMem.getReadCacheMisses() == 1);
+}
+
+// A block whose read failed must not be cached
+static void testFailedRead()
+{
+    FlakyEEPROM sim;
+    sim.begin(memory, 256);
+    sim.setTimeSource(micros);
+    for (int x = 0; x < 64; x++)
+        memory[x] = x;
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(256);
+    CHECK(myMem.begin(0x50, sim));
+    CHECK(myMem.enableReadCache(4));
+
+    uint8_t buffer[4];
+    sim.dead = true;
+    CHECK(myMem.read(4, buffer, 4) != 0);
+    sim.dead = false;
+    CHECK(myMem.read(4, buffer, 4) == 0);
+    for (int x = 0; x < 4; x++)
+        CHECK(buffer[x] == 4 + x);
+}
+
+int main()
+{
+    testHits();
+    testFailedRead();
+    printf("ok\n");
+    return (0);
+}
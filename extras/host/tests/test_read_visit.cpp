@@ -0,0 +1,52 @@
+// readVisit(): bursts in order, never across a 64k block, and early stop
+
+#include "HostTest.h"
+
+static uint8_t memory[262144];
+
+static uint32_t visitTotal = 0, visitCalls = 0, visitCrc = 0, visitNext = 0;
+
+static bool visit(uint32_t location, const uint8_t *data, uint16_t length)
+{
+    CHECK(location == visitNext);
+    CHECK(length <= I2C_BUFFER_LENGTH_RX);
+    CHECK((location >> 16) == ((location + length - 1) >> 16)); // Bursts never cross a 64k block
+    visitNext += length;
+    visitCrc = externalEEPROMCrc32(visitCrc, data, length);
+    visitTotal += length;
+    visitCalls++;
+    return (true);
+}
+
+static bool stopAfterThree(uint32_t, const uint8_t *, uint16_t)
+{
+    return (++visitCalls < 3);
+}
+
+static void testReadVisit()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 2048);
+    sim.setTimeSource(micros);
+    for (uint32_t x = 0; x < sizeof(memory); x++)
+        memory[x] = rand();
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(2048);
+    CHECK(myMem.begin(0x50, sim));
+
+    visitNext = 5;
+    CHECK(myMem.readVisit(5, 262139, visit) == 262139);
+    CHECK(visitTotal == 262139);
+    CHECK(visitCrc == externalEEPROMCrc32(0, memory + 5, 262139));
+    CHECK(myMem.crc32(5, 262139) == visitCrc);
+
+    visitCalls = 0;
+    CHECK(myMem.readVisit(0, 1000, stopAfterThree) == 3 * I2C_BUFFER_LENGTH_RX);
+}
+
+int main()
+{
+    testReadVisit();
+    printf("ok\n");
+    return (0);
+}
@@ -0,0 +1,56 @@
+// Bus counters and latency histograms (the Makefile builds with EXTERNAL_EEPROM_STATS=1)
+
+#include "HostTest.h"
+
+static uint8_t memory[65536];
+
+static uint32_t histogramTotal(struct_eepromStats &stats, int op)
+{
+    uint32_t total = 0;
+    for (int bucket = 0; bucket < EXTERNAL_EEPROM_LATENCY_BUCKETS; bucket++)
+        total += stats.latency_us[op][bucket];
+    return (total);
+}
+
+int main()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+
+    uint8_t data[300];
+    for (int x = 0; x < 300; x++)
+        data[x] = x;
+
+    myMem.resetStats();
+    myMem.write(0, data, 300);
+    struct_eepromStats stats;
+    CHECK(myMem.getStats(stats));
+    CHECK(stats.pageWrites == sim.getStats().pageWrites);
+    CHECK(stats.bytesOut >= 300);
+    CHECK(stats.nacks == stats.retries);
+    CHECK(histogramTotal(stats, EXTERNAL_EEPROM_OP_WRITE) == 1);
+    CHECK(histogramTotal(stats, EXTERNAL_EEPROM_OP_PAGE_WRITE) == stats.pageWrites);
+
+    myMem.resetStats();
+    uint32_t value = 0;
+    myMem.get(1000, value);
+    CHECK(myMem.getStats(stats));
+    CHECK(stats.bytesIn == 4);
+    CHECK(stats.pageWrites == 0);
+    CHECK(histogramTotal(stats, EXTERNAL_EEPROM_OP_READ) == 1);
+
+    // Blind writes wait without polling
+    myMem.resetStats();
+    myMem.disablePollForWriteComplete();
+    myMem.write(0, data, 64);
+    myMem.read(0, data, 64);
+    CHECK(myMem.getStats(stats));
+    CHECK(stats.nacks == 0);
+    CHECK(stats.bytesIn == 64);
+    printf("ok\n");
+    return (0);
+}
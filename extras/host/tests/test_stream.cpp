@@ -0,0 +1,55 @@
+// ExternalEEPROMStream: buffered byte access, seek, print and the region end
+
+#include "HostTest.h"
+#include "SparkFun_External_EEPROM_Stream.h"
+
+static uint8_t memory[32768];
+
+int main()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 256);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(256);
+    CHECK(myMem.begin(0x50, sim));
+
+    ExternalEEPROMStream stream;
+    CHECK(stream.begin(myMem, 1000, 10000));
+
+    sim.resetStats();
+    for (int x = 0; x < 5000; x++)
+        stream.write((uint8_t)(x * 7));
+    stream.flush();
+    CHECK(sim.getStats().pageWrites < 5000 / 16); // Gathered a page at a time
+
+    stream.seek(0);
+    for (int x = 0; x < 5000; x++)
+        CHECK(stream.read() == (uint8_t)(x * 7));
+
+    stream.seek(100);
+    stream.print("hello");
+    CHECK(stream.tell() == 105);
+    stream.seek(100);
+    char text[6] = {0};
+    CHECK(stream.read((uint8_t *)text, 5) == 5);
+    CHECK(strcmp(text, "hello") == 0);
+    CHECK(stream.peek() == (uint8_t)(105 * 7));
+
+    // A write lands in the loaded read buffer too
+    stream.seek(200);
+    stream.read();
+    stream.seek(201);
+    stream.write((uint8_t)0x42);
+    stream.seek(201);
+    CHECK(stream.read() == 0x42);
+
+    // End of the region
+    stream.seek(9999);
+    CHECK(stream.write((uint8_t)1) == 1);
+    CHECK(stream.write((uint8_t)1) == 0);
+    CHECK(stream.read() == -1);
+    stream.end();
+    printf("ok\n");
+    return (0);
+}
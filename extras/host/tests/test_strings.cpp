@@ -0,0 +1,65 @@
+// getString()/putString() and the length-prefixed blob APIs
+
+#include "HostTest.h"
+
+static uint8_t memory[65536];
+
+int main()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+
+    String text("Hi, I am just a simple test string that is longer than thirty two bytes for sure!");
+    CHECK(myMem.putString(30, text) == 30 + text.length() + 1);
+
+    delay(10); // Let the last page write finish so only the reads are counted
+    sim.resetStats();
+    String readBack;
+    myMem.getString(30, readBack);
+    CHECK(readBack == text);
+    CHECK(sim.getStats().transactions < 10); // Read in bursts, not a byte at a time
+
+    char buffer[100];
+    CHECK(myMem.getString(30, buffer, sizeof(buffer)) == text.length());
+    CHECK(strcmp(buffer, text.c_str()) == 0);
+    CHECK(myMem.getString(30, buffer, 10) == 9); // Truncated and terminated
+    CHECK(strncmp(buffer, text.c_str(), 9) == 0 && buffer[9] == 0);
+
+    myMem.putString(200, "const");
+    myMem.getString(200, readBack);
+    CHECK(readBack == "const");
+
+    CHECK(myMem.putBlob(500, (const uint8_t *)"abcdef", 6) == 508);
+    uint8_t blob[10];
+    CHECK(myMem.getBlob(500, blob, sizeof(blob)) == 6);
+    CHECK(memcmp(blob, "abcdef", 6) == 0);
+
+    // A small blob and its length go out in one page write
+    delay(10);
+    sim.resetStats();
+    myMem.putBlob(520, (const uint8_t *)"ghijkl", 6);
+    CHECK(sim.getStats().pageWrites == 1);
+
+    // Longer blobs, and one whose length straddles a page
+    uint8_t longBlob[300], longReadBack[300];
+    for (int x = 0; x < 300; x++)
+        longBlob[x] = x * 11 + 3;
+    uint32_t locations[] = {1000, 1151, 1279};
+    for (uint32_t location : locations)
+    {
+        CHECK(myMem.putBlob(location, longBlob, 300) == location + 302);
+        CHECK(myMem.getBlob(location, longReadBack, sizeof(longReadBack)) == 300);
+        CHECK(memcmp(longBlob, longReadBack, 300) == 0);
+    }
+
+    // Stops at the end of memory
+    memory[65535] = 'x';
+    myMem.getString(65535, readBack);
+    CHECK(readBack == "x");
+    printf("ok\n");
+    return (0);
+}
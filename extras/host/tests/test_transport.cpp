@@ -0,0 +1,151 @@
+// SimulatedEEPROM transport: the model itself, reads and writes across pages and blocks, and size
+// detection on every part type
+
+#include "HostTest.h"
+
+static uint8_t memory[262144];
+
+static void testReadWrite()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+
+    uint8_t data[300], readBack[300];
+    for (int x = 0; x < 300; x++)
+        data[x] = x * 7;
+    CHECK(myMem.write(100, data, 300) == 0);
+    CHECK(myMem.read(100, readBack, 300) == 0);
+    CHECK(memcmp(data, readBack, 300) == 0);
+    CHECK(memcmp(memory + 100, data, 300) == 0);
+
+    // The transfers themselves poll the busy part: no empty probes in between
+    sim.resetStats();
+    CHECK(myMem.write(100, data, 300) == 0);
+    struct_simulatedEEPROMStats stats = sim.getStats();
+    CHECK(stats.transactions == stats.pageWrites + stats.nacks);
+    sim.resetStats();
+    CHECK(myMem.read(100, readBack, 300) == 0);
+    stats = sim.getStats();
+    CHECK(stats.transactions == stats.nacks + 2 * ((300 + I2C_BUFFER_LENGTH_RX - 1) / I2C_BUFFER_LENGTH_RX));
+
+    // 24xx16: block select bits in the device address
+    SimulatedEEPROM smallSim;
+    smallSim.begin(memory, 16);
+    smallSim.setTimeSource(micros);
+    ExternalEEPROM smallMem;
+    smallMem.setMemoryType(16);
+    CHECK(smallMem.begin(0x50, smallSim));
+    smallMem.write(1000, data, 300);
+    memset(readBack, 0, sizeof(readBack));
+    smallMem.read(1000, readBack, 300);
+    CHECK(memcmp(data, readBack, 300) == 0);
+
+    // Reads after the write cycle has passed, with and without polling
+    for (int poll = 0; poll < 2; poll++)
+    {
+        ExternalEEPROM pollMem;
+        pollMem.setMemoryType(512);
+        CHECK(pollMem.begin(0x50, sim));
+        if (poll == 0)
+            pollMem.disablePollForWriteComplete();
+        pollMem.write(0, data, 200);
+        memset(readBack, 0, sizeof(readBack));
+        pollMem.read(0, readBack, 200);
+        CHECK(memcmp(data, readBack, 200) == 0);
+
+        // Once tWR has passed a read goes straight to the data: no probes, no NACKs
+        delay(100);
+        sim.resetStats();
+        pollMem.read(0, readBack, 200);
+        CHECK(sim.getStats().nacks == 0);
+        CHECK(sim.getStats().transactions == 2 * ((200 + I2C_BUFFER_LENGTH_RX - 1) / I2C_BUFFER_LENGTH_RX));
+    }
+}
+
+// The part itself: page buffer wrap, NACKs while programming, and the cost counters
+static void testSimulator()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    sim.setWriteTimeUs(5000);
+
+    sim.beginTransmission(0x50);
+    sim.write(0);
+    sim.write(126); // Two bytes before the end of page 0
+    for (int x = 0; x < 4; x++)
+        sim.write(0xA0 + x);
+    CHECK(sim.endTransmission() == 0);
+    CHECK(memory[126] == 0xA0 && memory[127] == 0xA1);
+    CHECK(memory[0] == 0xA2 && memory[1] == 0xA3); // Wrapped to the start of the page
+    CHECK(memory[128] == 0xFF);
+
+    sim.beginTransmission(0x50);
+    CHECK(sim.endTransmission() != 0); // Busy programming
+    delay(5);
+    sim.beginTransmission(0x50);
+    CHECK(sim.endTransmission() == 0);
+
+    sim.beginTransmission(0x51);
+    CHECK(sim.endTransmission() != 0); // Not our address
+
+    struct_simulatedEEPROMStats stats = sim.getStats();
+    CHECK(stats.pageWrites == 1);
+    CHECK(stats.transactions == 4);
+    CHECK(stats.nacks == 2);
+}
+
+static void testDetectMemorySize()
+{
+    uint16_t types[] = {0, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1025, 1026, 2048};
+    for (uint16_t type : types)
+    {
+        uint32_t size = type * 128;
+        if (type == 0)
+            size = 16;
+        else if (type == 1025 || type == 1026)
+            size = 131072;
+
+        for (int pattern = 0; pattern < 3; pattern++)
+        {
+            SimulatedEEPROM sim;
+            sim.begin(memory, type);
+            sim.setTimeSource(micros);
+            for (uint32_t x = 0; x < size; x++)
+                memory[x] = pattern == 0 ? 0xFF : pattern == 1 ? 0 : (uint8_t)(x * 7 + 3);
+
+            ExternalEEPROM myMem;
+            CHECK(myMem.begin(0x50, sim));
+            myMem.setAddressBytes(type <= 16 ? 1 : 2);
+            uint8_t before[16];
+            memcpy(before, memory, sizeof(before));
+            sim.resetStats();
+            CHECK(myMem.detectMemorySizeBytes() == size);
+            CHECK(sim.getStats().pageWrites <= 2); // One marker and one restore
+            CHECK(memcmp(before, memory, sizeof(before)) == 0); // Restored
+
+            if (size > 65536) // Upper blocks are addressed once the size is known
+            {
+                myMem.setMemorySizeBytes(size);
+                myMem.write(size - 5, 0x77);
+                CHECK(memory[size - 5] == 0x77);
+                uint8_t readBack[300];
+                myMem.read(65536 - 100, readBack, 300);
+                CHECK(memcmp(readBack, memory + 65536 - 100, 300) == 0);
+            }
+        }
+    }
+}
+
+int main()
+{
+    testSimulator();
+    testReadWrite();
+    testDetectMemorySize();
+    printf("ok\n");
+    return (0);
+}
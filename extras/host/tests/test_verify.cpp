@@ -0,0 +1,121 @@
+// Verify-after-write retries pages that did not program correctly
+
+#include "HostTest.h"
+
+static uint8_t memory[32768], image[4000], readBack[4000];
+
+// Flips a bit in every failEvery'th page write, or in all of them once stuck
+class NoisyBus : public ExternalEEPROMTransport
+{
+  public:
+    SimulatedEEPROM *sim;
+    int failEvery = 5;
+    bool stuck = false;
+
+    void beginTransmission(uint8_t i2cAddress)
+    {
+        sent = 0;
+        sim->beginTransmission(i2cAddress);
+    }
+    size_t write(uint8_t dataToWrite)
+    {
+        if (sent < 2)
+            address[sent] = dataToWrite;
+        sent++;
+        return (sim->write(dataToWrite));
+    }
+    uint8_t endTransmission(bool sendStop = true)
+    {
+        uint8_t result = sim->endTransmission(sendStop);
+        if (result == 0 && sendStop && sent > 2)
+        {
+            writes++;
+            if (stuck || writes % failEvery == 0)
+                memory[(address[0] << 8) | address[1]] ^= 0x10;
+        }
+        return (result);
+    }
+    size_t requestFrom(uint8_t i2cAddress, size_t length)
+    {
+        return (sim->requestFrom(i2cAddress, length));
+    }
+    int read()
+    {
+        return (sim->read());
+    }
+
+  private:
+    uint16_t sent = 0;
+    uint8_t address[2];
+    int writes = 0;
+};
+
+// Leaves the bus right after it accepts a page write, before the write can be read back
+class VanishingEEPROM : public FlakyEEPROM
+{
+  public:
+    uint8_t endTransmission(bool sendStop = true) override
+    {
+        uint8_t result = FlakyEEPROM::endTransmission(sendStop);
+        if (result == 0 && sendStop == true)
+            dead = true;
+        return (result);
+    }
+};
+
+static void testRetries()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 256);
+    sim.setTimeSource(micros);
+    NoisyBus bus;
+    bus.sim = &sim;
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(256);
+    CHECK(myMem.begin(0x50, bus));
+    for (uint32_t x = 0; x < sizeof(image); x++)
+        image[x] = rand();
+
+    CHECK(myMem.write(100, image, sizeof(image)) == 0);
+    myMem.read(100, readBack, sizeof(readBack));
+    CHECK(memcmp(image, readBack, sizeof(image)) != 0); // Corrupted silently
+
+    myMem.enableVerifyWrites(2);
+    CHECK(myMem.write(100, image, sizeof(image)) == 0);
+    myMem.read(100, readBack, sizeof(readBack));
+    CHECK(memcmp(image, readBack, sizeof(image)) == 0);
+    struct_verifyStats stats = myMem.getLastWriteVerifyStats();
+    CHECK(stats.pagesRetried > 0);
+    CHECK(stats.pagesFailed == 0);
+
+    bus.stuck = true;
+    CHECK(myMem.write(100, image, 60) == EXTERNAL_EEPROM_VERIFY_FAILED);
+    CHECK(myMem.getLastWriteVerifyStats().pagesFailed > 0);
+}
+
+// A read back that times out is reported as is, without rewriting the page
+static void testReadTimeout()
+{
+    VanishingEEPROM sim;
+    sim.begin(memory, 256);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(256);
+    CHECK(myMem.begin(0x50, sim));
+    sim.dead = false; // begin() probed the device
+    myMem.enableVerifyWrites(0);
+
+    sim.resetStats();
+    CHECK(myMem.write(100, image, 16) == EXTERNAL_EEPROM_TIMEOUT);
+    CHECK(sim.getStats().pageWrites == 1);
+    struct_verifyStats stats = myMem.getLastWriteVerifyStats();
+    CHECK(stats.pagesVerified == 0 && stats.pagesFailed == 0);
+}
+
+int main()
+{
+    testRetries();
+    testReadTimeout();
+    printf("ok\n");
+    return (0);
+}
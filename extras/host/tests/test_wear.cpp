@@ -0,0 +1,98 @@
+// Per-page wear counters: counting, hottest pages, histogram and reload
+
+#include "HostTest.h"
+
+static uint8_t memory[65536];
+
+static void testCounting()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+
+    uint32_t region = 65536 - myMem.getWearRegionSize();
+    CHECK(myMem.enableWearTracking(region));
+
+    uint32_t value = 0;
+    for (int x = 0; x < 1000; x++)
+        myMem.put(1000, ++value);
+    for (int x = 0; x < 300; x++)
+        myMem.put(5000, ++value);
+    uint8_t page[256] = {1};
+    myMem.write(0, page, 256);
+    CHECK(myMem.getPageWear(1000) == 1000);
+    CHECK(myMem.getPageWear(5000) == 300);
+    CHECK(myMem.getPageWear(0) > 0); // One count per TX buffer sized chunk
+    CHECK(myMem.getPageWear(128) == myMem.getPageWear(0));
+
+    uint32_t locations[4], totals[4];
+    CHECK(myMem.getWearHottest(locations, totals, 4) == 4);
+    CHECK(locations[0] == 896 && totals[0] == 1000);
+    CHECK(locations[1] == 4992 && totals[1] == 300);
+
+    uint32_t bands[4];
+    myMem.getWearHistogram(bands, 4, 100);
+    CHECK(bands[3] == 2); // 1000 and 300 land in the last band
+    myMem.disableWearTracking();
+    delay(10); // The final checkpoint is still programming
+
+    // Totals survive a restart
+    ExternalEEPROM restarted;
+    restarted.setMemoryType(512);
+    CHECK(restarted.begin(0x50, sim));
+    CHECK(restarted.enableWearTracking(region));
+    CHECK(restarted.getPageWear(1000) == 1000);
+
+    // A different layout starts over
+    restarted.disableWearTracking();
+    CHECK(restarted.enableWearTracking(region - 1024, 4));
+    CHECK(restarted.getPageWear(1000) == 0);
+}
+
+// More page writes to one counter in a single call than its RAM count can hold
+static void testLongWrite()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+    uint32_t region = 65536 - myMem.getWearRegionSize(512);
+
+    static uint8_t data[12000];
+    for (uint32_t x = 0; x < sizeof(data); x++)
+        data[x] = x * 3 + 1;
+    sim.resetStats();
+    myMem.write(0, data, sizeof(data));
+    uint32_t chunks = sim.getStats().pageWrites;
+    CHECK(chunks > 255);
+
+    // One counter for the whole part
+    CHECK(myMem.enableWearTracking(region, 512));
+    myMem.write(0, data, sizeof(data));
+    CHECK(myMem.getPageWear(0) == chunks);
+
+    CHECK(myMem.enableAsyncWrite(sizeof(data) + 16));
+    CHECK(myMem.writeAsync(0, data, sizeof(data)));
+    CHECK(myMem.waitForAsyncWrites());
+    CHECK(myMem.getPageWear(0) == 2 * chunks);
+    myMem.disableAsyncWrite();
+
+    // Checkpoints during the write leave its verify results alone
+    myMem.enableVerifyWrites();
+    myMem.write(0, data, sizeof(data));
+    CHECK(myMem.getLastWriteVerifyStats().pagesVerified == chunks);
+    CHECK(myMem.getPageWear(0) == 3 * chunks);
+}
+
+int main()
+{
+    testCounting();
+    testLongWrite();
+    printf("ok\n");
+    return (0);
+}
@@ -0,0 +1,56 @@
+// Write-back page cache: merging, read overlay, flush and deadline writes
+
+#include "HostTest.h"
+
+static uint8_t memory[65536];
+
+int main()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+    CHECK(myMem.enableWriteCache(2, 100));
+
+    sim.resetStats();
+    for (int x = 0; x < 50; x++)
+    {
+        uint16_t value = x * 3;
+        myMem.put(10 + x * 2, value);
+    }
+    CHECK(sim.getStats().pageWrites == 0); // All in one cached page
+    CHECK(myMem.getWriteCacheDirtyCount() == 1);
+
+    uint16_t value;
+    myMem.get(20, value);
+    CHECK(value == 15);
+    myMem.write(300, 0xAB);
+    CHECK(myMem.read(300) == 0xAB);
+
+    uint8_t data[400], readBack[400];
+    for (int x = 0; x < 400; x++)
+        data[x] = x ^ 0x5A;
+    myMem.write(1000, data, 400);
+    myMem.flush();
+    CHECK(myMem.getWriteCacheDirtyCount() == 0);
+
+    for (int x = 0; x < 50; x++)
+        CHECK(memory[10 + x * 2] == (uint8_t)(x * 3));
+    CHECK(memory[300] == 0xAB);
+    CHECK(memcmp(memory + 1000, data, 400) == 0);
+    myMem.read(1000, readBack, 400);
+    CHECK(memcmp(readBack, data, 400) == 0);
+
+    // update() records a line once it is past its deadline
+    myMem.write(2000, 1);
+    CHECK(memory[2000] != 1);
+    delay(200);
+    myMem.update();
+    CHECK(memory[2000] == 1);
+
+    myMem.disableWriteCache();
+    printf("ok\n");
+    return (0);
+}
@@ -0,0 +1,82 @@
+// Adaptive write time: the estimate tracks tWR and blind writes use it
+
+#include "HostTest.h"
+
+static uint8_t memory[65536], data[4096], readBack[4096];
+
+static void testAdaptive()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    sim.setWriteTimeUs(3300);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+
+    for (uint32_t x = 0; x < sizeof(data); x++)
+        data[x] = rand();
+    myMem.write(0, data, sizeof(data));
+    myMem.read(0, readBack, sizeof(readBack));
+    CHECK(memcmp(data, readBack, sizeof(data)) == 0);
+    CHECK(myMem.getWriteTimeSamples() > 0);
+    CHECK(myMem.getWriteTimeMeanUs() >= 3300 && myMem.getWriteTimeMeanUs() < 3500);
+    CHECK(myMem.getWriteTimeLimitUs() >= myMem.getWriteTimeMeanUs());
+
+    // Blind writes wait for the learned time instead of writeTime_ms
+    myMem.disablePollForWriteComplete();
+    for (uint32_t x = 0; x < sizeof(data); x++)
+        data[x] = rand();
+    unsigned long adaptiveTime = micros();
+    myMem.write(0, data, sizeof(data));
+    adaptiveTime = micros() - adaptiveTime;
+    myMem.read(0, readBack, sizeof(readBack));
+    CHECK(memcmp(data, readBack, sizeof(data)) == 0);
+
+    myMem.disableAdaptiveWriteTime();
+    unsigned long fixedTime = micros();
+    myMem.write(0, data + 1, sizeof(data) - 1);
+    fixedTime = micros() - fixedTime;
+    CHECK(adaptiveTime < fixedTime);
+
+    // Follows a change in tWR
+    myMem.enableAdaptiveWriteTime();
+    myMem.enablePollForWriteComplete();
+    myMem.resetWriteTimeEstimate();
+    sim.setWriteTimeUs(2000);
+    for (int pass = 0; pass < 2; pass++)
+        myMem.write(0, data, sizeof(data));
+    CHECK(myMem.getWriteTimeMeanUs() >= 2000 && myMem.getWriteTimeMeanUs() < 2300);
+
+    CHECK(myMem.detectWriteTimeMs() >= 2);
+}
+
+// The write cache must not absorb the test writes, or there is nothing to time
+static void testDetectCached()
+{
+    SimulatedEEPROM sim;
+    sim.begin(memory, 512);
+    sim.setTimeSource(micros);
+    sim.setWriteTimeUs(3300);
+    ExternalEEPROM myMem;
+    myMem.setMemoryType(512);
+    CHECK(myMem.begin(0x50, sim));
+    CHECK(myMem.enableWriteCache(2));
+    memory[5] = 0x42;
+
+    sim.resetStats();
+    CHECK(myMem.detectWriteTimeMs() == 4); // 3.3ms plus 10%, rounded up
+    CHECK(sim.getStats().pageWrites == 9); // Eight samples and the restore
+    CHECK(myMem.getWriteTimeSamples() == 8);
+    CHECK(myMem.getWriteTimeMeanUs() >= 3300 && myMem.getWriteTimeMeanUs() < 4000); // Within one poll interval
+    delay(10);
+    CHECK(memory[5] == 0x42);
+}
+
+int main()
+{
+    testAdaptive();
+    testDetectCached();
+    printf("ok\n");
+    return (0);
+}
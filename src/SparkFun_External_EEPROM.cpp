@@ -35,6 +35,8 @@ bool ExternalEEPROM::begin(uint8_t deviceAddress, TwoWire &wirePort, uint8_t WP)
         settings.wpPin = WP;
     }
     settings.i2cPort = &wirePort; // Grab which port the user wants us to use
+    wireTransport.i2cPort = &wirePort;
+    transport = &wireTransport;
     settings.deviceAddress = deviceAddress;
 
     if (isConnected() == false)
@@ -73,15 +75,103 @@ bool ExternalEEPROM::begin(uint8_t deviceAddress, TwoWire &wirePort, uint8_t WP)
     return true;
 }
 
+// Begin using a caller supplied transport instead of a TwoWire port
+// Useful for alternate I2C drivers or for running against a SimulatedEEPROM
+bool ExternalEEPROM::begin(uint8_t deviceAddress, ExternalEEPROMTransport &transportPort, uint8_t WP)
+{
+    if (WP != 255)
+    {
+        pinMode(WP, OUTPUT);
+        digitalWrite(WP, HIGH);
+        settings.wpPin = WP;
+    }
+    transport = &transportPort;
+    settings.deviceAddress = deviceAddress;
+
+    return (isConnected());
+}
+
+ExternalEEPROMTransport *ExternalEEPROM::getTransport()
+{
+    return (transport);
+}
+
 // Erase entire EEPROM
+// Pages that already hold the erase value are not rewritten
 void ExternalEEPROM::erase(uint8_t toWrite)
 {
-    uint8_t tempBuffer[settings.pageSize_bytes];
-    for (uint32_t x = 0; x < settings.pageSize_bytes; x++)
-        tempBuffer[x] = toWrite;
+    fill(0, length(), toWrite);
+}
+
+// Set a range of memory to a given value
+// Each page is read back first. Only page writes whose bytes differ from the fill value are sent, so
+// mostly blank parts are erased at read speed instead of one write cycle per page.
+// The optional progress callback is called after each page with the bytes processed and the total.
+// Returns the number of page writes used. See getFillPagesSkipped() for the number of pages left untouched.
+uint32_t ExternalEEPROM::fill(uint32_t eepromLocation, uint32_t length, uint8_t toWrite,
+                              void (*progressCallback)(uint32_t bytesDone, uint32_t bytesTotal))
+{
+    // Error check
+    if (eepromLocation >= settings.memorySize_bytes)
+        length = 0;
+    else if (eepromLocation + length > settings.memorySize_bytes)
+        length = settings.memorySize_bytes - eepromLocation;
+
+    fillPagesSkipped = 0;
+    fillPageWrites = 0;
+
+    uint8_t fillBuffer[I2C_BUFFER_LENGTH_TX];
+    memset(fillBuffer, toWrite, sizeof(fillBuffer));
+    uint8_t deviceBuffer[I2C_BUFFER_LENGTH_TX];
+
+    uint32_t done = 0;
+    while (done < length)
+    {
+        // Work on one page at a time
+        uint32_t location = eepromLocation + done;
+        uint32_t pageRemaining = settings.pageSize_bytes - (location % settings.pageSize_bytes);
+        if (pageRemaining > length - done)
+            pageRemaining = length - done;
+
+        bool pageWritten = false;
+        uint32_t pageDone = 0;
+        while (pageDone < pageRemaining)
+        {
+            // Largest piece that can be recorded with a single page write
+            uint16_t amtToCheck = getWriteChunkSize(location + pageDone, pageRemaining - pageDone);
+
+            read(location + pageDone, deviceBuffer, amtToCheck);
+            if (memcmp(deviceBuffer, fillBuffer, amtToCheck) != 0)
+            {
+                write(location + pageDone, fillBuffer, amtToCheck);
+                fillPageWrites++;
+                pageWritten = true;
+            }
+            pageDone += amtToCheck;
+        }
+
+        if (pageWritten == false)
+            fillPagesSkipped++;
+
+        done += pageRemaining;
+
+        if (progressCallback != nullptr)
+            progressCallback(done, length);
+    }
+
+    return (fillPageWrites);
+}
+
+// Pages the last fill() or erase() found already holding the fill value
+uint32_t ExternalEEPROM::getFillPagesSkipped()
+{
+    return (fillPagesSkipped);
+}
 
-    for (uint32_t addr = 0; addr < length(); addr += settings.pageSize_bytes)
-        write(addr, tempBuffer, settings.pageSize_bytes);
+// Page writes the last fill() or erase() needed
+uint32_t ExternalEEPROM::getFillPageWrites()
+{
+    return (fillPageWrites);
 }
 
 uint32_t ExternalEEPROM::length()
@@ -95,8 +185,10 @@ bool ExternalEEPROM::isConnected(uint8_t i2cAddress)
     if (i2cAddress == 255)
         i2cAddress = settings.deviceAddress; // We can't set the default to settings.deviceAddress so we use 255 instead
 
-    settings.i2cPort->beginTransmission((uint8_t)i2cAddress);
-    if (settings.i2cPort->endTransmission() == 0)
+    transport->beginTransmission((uint8_t)i2cAddress);
+    uint8_t result = transport->endTransmission();
+    countTransfer(0, 0, result);
+    if (result == 0)
         return (true);
     return (false);
 }
@@ -185,6 +277,10 @@ void ExternalEEPROM::setMemorySizeBytes(uint32_t memSize)
         setAddressBytes(2);
         setPageSizeBytes(128);
         break;
+    case (131072):
+        setAddressBytes(2);
+        setPageSizeBytes(128);
+        break;
     case (262144):
         setAddressBytes(2);
         setPageSizeBytes(256);
@@ -239,13 +335,30 @@ void ExternalEEPROM::setMemoryType(uint16_t typeNumber)
         break;
     case (1025):
         setMemorySizeBytes(128000); //128000
+        setBlockSelectShift(2); // B0 is in the A2 position
+        break;
+    case (1026):
+        setMemorySizeBytes(131072); //131072
+        setBlockSelectShift(0); // A16 is in the A0 position
         break;
     case (2048):
         setMemorySizeBytes(262144); //262144
+        setBlockSelectShift(0); // A17/A16 are in the A1/A0 positions
         break;
     }
 }
 
+// Set where the upper address bits (A16 and up) of >512kbit EEPROMs go in the I2C address
+// 2 for the 24xx1025 (B0 in the A2 position), 0 for the 24xx1026 and 24xxM02
+void ExternalEEPROM::setBlockSelectShift(uint8_t shift)
+{
+    settings.blockSelectShift = shift;
+}
+uint8_t ExternalEEPROM::getBlockSelectShift()
+{
+    return settings.blockSelectShift;
+}
+
 // Old get/setPageSize. Use get/setPageSizeBytes
 void ExternalEEPROM::setPageSize(uint16_t pageSize)
 {
@@ -290,14 +403,21 @@ uint8_t ExternalEEPROM::detectWriteTimeMs(uint8_t numberOfTests)
     uint8_t originalValue = read(testLocation); // Preserve data before we start writing
 
     uint32_t totalTime = 0;
+    uint8_t samples = 0;
     const uint8_t percentOverage = 10;
 
+    flush(); // The samples below bypass the write cache, so it must not hold anything newer
+
     // Create copy of internal settings before test
     uint32_t originalMemorySize = settings.memorySize_bytes;
     bool originalpollForWriteComplete = settings.pollForWriteComplete;
+    bool originalVerifyWrites = verifyWrites;
 
-    setMemorySizeBytes(128); // Assume the smallest memory size during test
+    // Assume the smallest memory size during test. Set directly: setMemorySizeBytes(128) would also switch to
+    // one address byte and 8 byte pages, which misaddresses two address byte parts and is not restored below.
+    settings.memorySize_bytes = 128;
     settings.pollForWriteComplete = true;
+    verifyWrites = false; // A read back would wait out the write before it could be timed
 
     // We can't run this test if we don't know the number of address bytes
     if (settings.addressSize_bytes == 0)
@@ -314,28 +434,46 @@ uint8_t ExternalEEPROM::detectWriteTimeMs(uint8_t numberOfTests)
             magicValue = random(1, 255); // (Inclusive, exclusive)
         } while (magicValue == originalValue);
 
-        unsigned long startTime = micros();
-        write(testLocation, magicValue); // Does a read before write. Uses polling.
-
-        // Wait until write completes
-        while (isBusy(settings.deviceAddress) == true) // Poll device's original address, not the modified one
-            delayMicroseconds(100); // This shortens the amount of time waiting between writes but hammers the I2C bus
+        // Straight to the device. write() could leave the byte in the write cache, or skip it if it already
+        // matches, and then there would be no page write to time.
+        writeBlock(testLocation, &magicValue, 1);
 
+        // Wait until write completes, timed from the end of the page write
         unsigned long stopTime = micros();
-        totalTime += (stopTime - startTime);
+        unsigned long pollStart_us = stopTime;
+        bool wasBusy = false;
+        for (uint8_t polls = 0; isBusy(settings.deviceAddress) == true; polls++) // Poll device's original address
+        {
+            wasBusy = true;
+            countPoll();
+            if (backOff(pollStart_us, polls) == false)
+                break; // Device is gone
+            stopTime = micros();
+        }
+        writeOutstanding = false;
+
+        if (wasBusy == false)
+            continue; // Done before the first poll, or never started. Nothing to time.
+        totalTime += (stopTime - lastPageWrite_us);
+        samples++;
+        addWriteTimeSample(stopTime - lastPageWrite_us); // Seeds the adaptive write time
 
         // Serial.print("delta: ");
-        // Serial.println((stopTime - startTime));
+        // Serial.println((stopTime - lastPageWrite_us));
     }
 
     //  Return spot to its original value
-    write(testLocation, originalValue);
+    writeBlock(testLocation, &originalValue, 1);
 
     // Return original settings
     settings.memorySize_bytes = originalMemorySize;
     settings.pollForWriteComplete = originalpollForWriteComplete;
+    verifyWrites = originalVerifyWrites;
+
+    if (samples == 0)
+        return (settings.writeTime_ms); // Nothing measured, keep the current setting
 
-    uint16_t avgTimeUs = totalTime / numberOfTests;
+    uint16_t avgTimeUs = totalTime / samples;
 
     // Serial.print("avgTimeUs: ");
     // Serial.println(avgTimeUs);
@@ -346,6 +484,229 @@ uint8_t ExternalEEPROM::detectWriteTimeMs(uint8_t numberOfTests)
     return (settings.writeTime_ms);
 }
 
+// The write time is learned from the page writes the library already polls for. Each wait that sees the
+// device busy and then ready, or that sleeps through the holdoff, adds a sample measured from the end of
+// the page write to the first poll that was answered. The mean and variance are running averages over
+// the last few samples (weight 1/8), so they follow changes in temperature, supply voltage, and wear.
+void ExternalEEPROM::enableAdaptiveWriteTime()
+{
+    adaptiveWriteTime = true;
+}
+void ExternalEEPROM::disableAdaptiveWriteTime()
+{
+    adaptiveWriteTime = false;
+}
+
+// Forget the learned write time and go back to writeTime_ms
+void ExternalEEPROM::resetWriteTimeEstimate()
+{
+    writeTimeSamples = 0;
+    writeTimeMean_us = 0;
+    writeTimeVariance = 0;
+}
+
+uint32_t ExternalEEPROM::getWriteTimeMeanUs()
+{
+    return (writeTimeMean_us);
+}
+
+// Standard deviation of the learned write time
+uint32_t ExternalEEPROM::getWriteTimeDeviationUs()
+{
+    // Integer square root, one result bit at a time
+    uint32_t remainder = writeTimeVariance;
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > remainder)
+        bit >>= 2;
+    while (bit != 0)
+    {
+        if (remainder >= root + bit)
+        {
+            remainder -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+            root >>= 1;
+        bit >>= 2;
+    }
+    return (root);
+}
+
+uint16_t ExternalEEPROM::getWriteTimeSamples()
+{
+    return (writeTimeSamples);
+}
+
+// Time after which a page write is taken to be finished: the learned mean plus four standard deviations
+// (and at least 10% over the mean), or writeTime_ms until enough writes have been timed.
+// This is the delay used when polling is disabled.
+uint32_t ExternalEEPROM::getWriteTimeLimitUs()
+{
+    if (adaptiveWriteTime == false || writeTimeSamples < writeTimeMinimumSamples)
+        return (settings.writeTime_ms * 1000UL);
+
+    uint32_t deviation_us = getWriteTimeDeviationUs();
+    uint32_t margin_us = 4 * deviation_us;
+    if (margin_us < writeTimeMean_us / 10)
+        margin_us = writeTimeMean_us / 10;
+    return (writeTimeMean_us + margin_us);
+}
+
+// Time after a page write before the first poll: the learned mean less two standard deviations (at least 1/16)
+// Nearly every write is still in progress by then so the first poll is rarely wasted, and little time is lost
+// sleeping past the end of a write. The poll policy's holdoff until enough writes have been timed.
+uint32_t ExternalEEPROM::getWriteHoldoffUs()
+{
+    if (adaptiveWriteTime == false || writeTimeSamples < writeTimeMinimumSamples)
+        return (pollPolicy.holdoff_us);
+
+    uint32_t margin_us = 2 * getWriteTimeDeviationUs();
+    if (margin_us < writeTimeMean_us / 16)
+        margin_us = writeTimeMean_us / 16; // Some writes must finish inside the holdoff or the estimate can't shrink
+    if (margin_us >= writeTimeMean_us)
+        return (0);
+    return (writeTimeMean_us - margin_us);
+}
+
+// Add a measured write time to the estimate
+void ExternalEEPROM::learnWriteTime(uint32_t writeTime_us)
+{
+    if (adaptiveWriteTime == true && lastPageWriteAddress == settings.deviceAddress)
+        addWriteTimeSample(writeTime_us);
+}
+
+void ExternalEEPROM::addWriteTimeSample(uint32_t writeTime_us)
+{
+    if (writeTimeSamples == 0)
+    {
+        writeTimeSamples = 1;
+        writeTimeMean_us = writeTime_us;
+        writeTimeVariance = 0;
+        return;
+    }
+
+    if (writeTimeSamples < 0xFFFF)
+        writeTimeSamples++;
+    uint8_t weight = (writeTimeSamples < 8) ? writeTimeSamples : 8; // Plain average until there are 8 samples
+
+    uint32_t difference_us;
+    if (writeTime_us >= writeTimeMean_us)
+    {
+        difference_us = writeTime_us - writeTimeMean_us;
+        writeTimeMean_us += difference_us / weight;
+    }
+    else
+    {
+        difference_us = writeTimeMean_us - writeTime_us;
+        writeTimeMean_us -= difference_us / weight;
+    }
+
+    if (difference_us > 0xFFFF)
+        difference_us = 0xFFFF; // Keeps the square in range
+    uint32_t square = difference_us * difference_us;
+    if (square >= writeTimeVariance)
+        writeTimeVariance += (square - writeTimeVariance) / weight;
+    else
+        writeTimeVariance -= (writeTimeVariance - square) / weight;
+}
+
+// True if the last page write started too recently for a poll to be worth sending
+bool ExternalEEPROM::isWriteCycleEarly()
+{
+    if (writeOutstanding == false || lastPageWriteAddress != settings.deviceAddress)
+        return (false);
+    return (micros() - lastPageWrite_us < getWriteHoldoffUs());
+}
+
+// Sleep until the learned write time says the last page write is about to finish
+// Returns true if it slept. The next poll then times the write even if the device is already done; without
+// those samples the estimate could only ever grow.
+bool ExternalEEPROM::holdOffWriteCycle()
+{
+    if (isWriteCycleEarly() == false)
+        return (false);
+
+    unsigned long wait_us = startTiming();
+    pollSleep(getWriteHoldoffUs() - (micros() - lastPageWrite_us));
+    endTiming(EXTERNAL_EEPROM_OP_WRITE_WAIT, wait_us);
+    return (true);
+}
+
+// How the library waits for a busy device. A page write takes a few ms, during which the device NACKs
+// everything. Each wait sleeps through the holdoff, then polls with growing gaps until the device
+// answers or the timeout passes. See struct_pollPolicy for the defaults.
+void ExternalEEPROM::setPollPolicy(const struct_pollPolicy &policy)
+{
+    pollPolicy = policy;
+    if (pollPolicy.interval_us == 0)
+        pollPolicy.interval_us = 1;
+    if (pollPolicy.maxInterval_us < pollPolicy.interval_us)
+        pollPolicy.maxInterval_us = pollPolicy.interval_us;
+}
+struct_pollPolicy ExternalEEPROM::getPollPolicy()
+{
+    return (pollPolicy);
+}
+
+// Called repeatedly while the library waits on the device (ie, yield() or an RTOS delay)
+// Pass nullptr to go back to delay()
+void ExternalEEPROM::setPollYield(void (*yieldCallback)())
+{
+    pollYield = yieldCallback;
+}
+
+// Sleep before poll number pollCount of a wait that started at waitStart_us
+// Returns false, without sleeping, once the poll timeout has passed
+bool ExternalEEPROM::backOff(unsigned long waitStart_us, uint8_t pollCount)
+{
+    return (externalEEPROMBackOff(pollPolicy, waitStart_us, pollCount, pollYield));
+}
+
+// Sleep while the device is busy, handing the time to the yield callback if there is one
+void ExternalEEPROM::pollSleep(uint32_t sleep_us)
+{
+    externalEEPROMPollSleep(sleep_us, pollYield);
+}
+
+bool externalEEPROMBackOff(const struct_pollPolicy &policy, unsigned long waitStart_us, uint8_t pollCount,
+                           void (*yieldCallback)())
+{
+    uint32_t interval_us = policy.interval_us;
+    if (policy.backoff == EXTERNAL_EEPROM_BACKOFF_STEPPED)
+        interval_us *= (uint32_t)pollCount + 1;
+    else if (policy.backoff == EXTERNAL_EEPROM_BACKOFF_EXPONENTIAL)
+        interval_us <<= (pollCount < 16) ? pollCount : 16;
+    if (interval_us > policy.maxInterval_us)
+        interval_us = policy.maxInterval_us;
+
+    if (policy.timeout_us > 0)
+    {
+        uint32_t elapsed_us = micros() - waitStart_us;
+        if (elapsed_us >= policy.timeout_us)
+            return (false);
+        if (interval_us > policy.timeout_us - elapsed_us)
+            interval_us = policy.timeout_us - elapsed_us; // Make the last poll right at the timeout
+    }
+
+    externalEEPROMPollSleep(interval_us, yieldCallback);
+    return (true);
+}
+
+void externalEEPROMPollSleep(uint32_t sleep_us, void (*yieldCallback)())
+{
+    if (yieldCallback == nullptr)
+    {
+        delay(sleep_us / 1000);
+        delayMicroseconds(sleep_us % 1000);
+        return;
+    }
+
+    unsigned long start_us = micros();
+    while (micros() - start_us < sleep_us)
+        yieldCallback();
+}
+
 void ExternalEEPROM::enablePollForWriteComplete()
 {
     settings.pollForWriteComplete = true;
@@ -360,36 +721,399 @@ constexpr uint16_t ExternalEEPROM::getI2CBufferSize()
     return I2C_BUFFER_LENGTH_TX;
 }
 
-uint32_t ExternalEEPROM::putString(uint32_t eepromLocation, String &strToWrite)
+// Record a copy of data into an unused slot, or the oldest one that is not the newest intact copy
+// The data pages are written first and the header last. Until the header lands, the slot's old header
+// no longer matches its data so readAtomic() falls back to the previous copy.
+// Returns the result of the last I2C endTransmission
+int ExternalEEPROM::writeAtomic(uint32_t eepromLocation, const uint8_t *data, uint16_t length,
+                                uint8_t numberOfSlots)
+{
+    if (numberOfSlots < 2)
+        numberOfSlots = 2;
+
+    uint32_t slotSize = getAtomicSlotSize(length);
+
+    struct_atomicHeader header;
+    uint32_t newestGeneration;
+    int8_t intactSlot = findAtomicSlot(eepromLocation, length, numberOfSlots, nullptr, header, newestGeneration);
+
+    uint8_t targetSlot = 0;
+    uint32_t oldestGeneration = 0xFFFFFFFF;
+    for (uint8_t slot = 0; slot < numberOfSlots; slot++)
+    {
+        if (slot == intactSlot)
+            continue;
+        uint32_t generation = 0; // Unused or damaged
+        if (readAtomicHeader(eepromLocation + slot * slotSize, length, header) == true)
+            generation = header.generation;
+        if (generation < oldestGeneration)
+        {
+            targetSlot = slot;
+            oldestGeneration = generation;
+        }
+    }
+
+    header.generation = newestGeneration + 1;
+    header.length = length;
+    header.dataCrc = externalEEPROMCrc32(0, data, length);
+    header.headerCrc = externalEEPROMCrc32(0, (const uint8_t *)&header, sizeof(header) - sizeof(header.headerCrc));
+
+    // Cached pages could be recorded in any order, so record everything pending first and
+    // then write the slot straight to the device, keeping any cached copies of its pages current
+    flush();
+
+    uint32_t slotLocation = eepromLocation + targetSlot * slotSize;
+    updateWriteCache(slotLocation, data, length);
+    int result = writeBlock(slotLocation, data, length);
+    if (result != 0)
+        return (result);
+
+    updateWriteCache(slotLocation + length, (const uint8_t *)&header, sizeof(header));
+    result = writeBlock(slotLocation + length, (const uint8_t *)&header, sizeof(header));
+    if (result == 0)
+        atomicGeneration = header.generation;
+    return (result);
+}
+
+// Read the newest copy whose header and data are intact
+// Returns false if there is none. data may have been overwritten in that case.
+bool ExternalEEPROM::readAtomic(uint32_t eepromLocation, uint8_t *data, uint16_t length, uint8_t numberOfSlots)
+{
+    if (numberOfSlots < 2)
+        numberOfSlots = 2;
+
+    struct_atomicHeader header;
+    uint32_t newestGeneration;
+    if (findAtomicSlot(eepromLocation, length, numberOfSlots, data, header, newestGeneration) == -1)
+    {
+        atomicGeneration = 0;
+        return (false);
+    }
+    atomicGeneration = header.generation;
+    return (true);
+}
+
+// Return the slot holding the newest intact copy, or -1 if there is none
+// Headers are read first, then only the data of the newest slot. If that data fails its CRC
+// (an interrupted write), the next newest slot is tried. The data is read into buff, or
+// streamed through the CRC if buff is nullptr.
+// newestGeneration is set to the highest generation of any readable header, intact or not.
+int8_t ExternalEEPROM::findAtomicSlot(uint32_t eepromLocation, uint16_t length, uint8_t numberOfSlots, uint8_t *buff,
+                                      struct_atomicHeader &header, uint32_t &newestGeneration)
+{
+    uint32_t slotSize = getAtomicSlotSize(length);
+    uint32_t generationLimit = 0xFFFFFFFF; // Only consider copies older than the last one that failed
+    newestGeneration = 0;
+
+    while (true)
+    {
+        int8_t bestSlot = -1;
+        for (uint8_t slot = 0; slot < numberOfSlots; slot++)
+        {
+            struct_atomicHeader slotHeader;
+            if (readAtomicHeader(eepromLocation + slot * slotSize, length, slotHeader) == false)
+                continue;
+            if (slotHeader.generation > newestGeneration)
+                newestGeneration = slotHeader.generation;
+            if (slotHeader.generation < generationLimit &&
+                (bestSlot == -1 || slotHeader.generation > header.generation))
+            {
+                bestSlot = slot;
+                header = slotHeader;
+            }
+        }
+
+        if (bestSlot == -1)
+            return (-1);
+
+        uint32_t dataCrc;
+        if (buff != nullptr)
+        {
+            read(eepromLocation + bestSlot * slotSize, buff, length);
+            dataCrc = externalEEPROMCrc32(0, buff, length);
+        }
+        else
+            dataCrc = crc32(eepromLocation + bestSlot * slotSize, length);
+
+        if (dataCrc == header.dataCrc)
+            return (bestSlot);
+        generationLimit = header.generation;
+    }
+}
+
+uint32_t ExternalEEPROM::getAtomicSize(uint16_t length, uint8_t numberOfSlots)
+{
+    if (numberOfSlots < 2)
+        numberOfSlots = 2;
+    return (getAtomicSlotSize(length) * numberOfSlots);
+}
+
+uint32_t ExternalEEPROM::getAtomicGeneration()
+{
+    return (atomicGeneration);
+}
+
+// Slots are rounded up to whole pages so a page write to one slot can never disturb another
+uint32_t ExternalEEPROM::getAtomicSlotSize(uint16_t length)
+{
+    uint32_t slotSize = length + sizeof(struct_atomicHeader);
+    if (slotSize % settings.pageSize_bytes != 0)
+        slotSize += settings.pageSize_bytes - (slotSize % settings.pageSize_bytes);
+    return (slotSize);
+}
+
+// The header sits directly after the data. Returns false if the header is damaged, unused, or for another size.
+bool ExternalEEPROM::readAtomicHeader(uint32_t slotLocation, uint16_t length, struct_atomicHeader &header)
+{
+    read(slotLocation + length, (uint8_t *)&header, sizeof(header));
+    if (externalEEPROMCrc32(0, (const uint8_t *)&header, sizeof(header) - sizeof(header.headerCrc)) != header.headerCrc)
+        return (false);
+    return (header.length == length);
+}
+
+// Checksums of a range of the device
+// The range is streamed through a stack buffer one I2C read at a time (see readVisit()), so any length can be checked
+uint32_t ExternalEEPROM::crc32(uint32_t eepromLocation, uint32_t length)
+{
+    uint8_t buff[I2C_BUFFER_LENGTH_RX];
+    uint32_t crc = 0;
+    while (length > 0)
+    {
+        uint16_t amtToRead = getReadChunkSize(eepromLocation, length);
+        read(eepromLocation, buff, amtToRead);
+        crc = externalEEPROMCrc32(crc, buff, amtToRead);
+        eepromLocation += amtToRead;
+        length -= amtToRead;
+    }
+    return (crc);
+}
+
+uint16_t ExternalEEPROM::crc16(uint32_t eepromLocation, uint32_t length)
+{
+    uint8_t buff[I2C_BUFFER_LENGTH_RX];
+    uint16_t crc = 0xFFFF;
+    while (length > 0)
+    {
+        uint16_t amtToRead = getReadChunkSize(eepromLocation, length);
+        read(eepromLocation, buff, amtToRead);
+        crc = externalEEPROMCrc16(crc, buff, amtToRead);
+        eepromLocation += amtToRead;
+        length -= amtToRead;
+    }
+    return (crc);
+}
+
+// Compare a range of the device against data
+// Stops reading at the first I2C read that contains a difference
+bool ExternalEEPROM::verify(uint32_t eepromLocation, const uint8_t *data, uint32_t length)
+{
+    uint8_t buff[I2C_BUFFER_LENGTH_RX];
+    while (length > 0)
+    {
+        uint16_t amtToRead = getReadChunkSize(eepromLocation, length);
+        read(eepromLocation, buff, amtToRead);
+        if (memcmp(buff, data, amtToRead) != 0)
+            return (false);
+        eepromLocation += amtToRead;
+        data += amtToRead;
+        length -= amtToRead;
+    }
+    return (true);
+}
+
+uint32_t ExternalEEPROM::putString(uint32_t eepromLocation, const String &strToWrite)
+{
+    return (putString(eepromLocation, strToWrite.c_str()));
+}
+
+// Write a string including its terminator. Returns the location after the terminator.
+uint32_t ExternalEEPROM::putString(uint32_t eepromLocation, const char *strToWrite)
 {
-    uint16_t strLen = strToWrite.length() + 1;
-    write(eepromLocation, (uint8_t *)strToWrite.c_str(), strLen);
+    uint16_t strLen = strlen(strToWrite) + 1;
+    write(eepromLocation, (const uint8_t *)strToWrite, strLen);
     return (eepromLocation + strLen);
 }
+
+// Read a terminated string into a String
+// The string is read in I2C_BUFFER_LENGTH_RX sized bursts and appended one burst at a time
 void ExternalEEPROM::getString(uint32_t eepromLocation, String &strToRead)
 {
     if (strToRead.length())
     {
         strToRead.remove(0, strToRead.length());
     }
-    uint8_t tmp = 65; // dummy
-    while (tmp != 0)
+
+    char chunk[I2C_BUFFER_LENGTH_RX + 1];
+    while (eepromLocation < settings.memorySize_bytes)
+    {
+        uint16_t amtToRead = I2C_BUFFER_LENGTH_RX;
+        if (eepromLocation + amtToRead > settings.memorySize_bytes)
+            amtToRead = settings.memorySize_bytes - eepromLocation; // Stop at the end of memory
+
+        read(eepromLocation, (uint8_t *)chunk, amtToRead);
+        chunk[amtToRead] = '\0';
+
+        uint16_t chunkLength = strlen(chunk);
+        strToRead += chunk;
+        if (chunkLength < amtToRead)
+            break; // Found the terminator
+
+        eepromLocation += amtToRead;
+    }
+}
+
+// Read a terminated string into a caller buffer without any allocation
+// At most bufferSize - 1 characters are read. The buffer is always terminated.
+// Returns the length of the string read.
+uint16_t ExternalEEPROM::getString(uint32_t eepromLocation, char *strToRead, uint16_t bufferSize)
+{
+    if (bufferSize == 0)
+        return (0);
+
+    uint16_t received = 0;
+    while (received < bufferSize - 1 && eepromLocation + received < settings.memorySize_bytes)
+    {
+        uint16_t amtToRead = bufferSize - 1 - received;
+        if (amtToRead > I2C_BUFFER_LENGTH_RX)
+            amtToRead = I2C_BUFFER_LENGTH_RX;
+        if (eepromLocation + received + amtToRead > settings.memorySize_bytes)
+            amtToRead = settings.memorySize_bytes - (eepromLocation + received); // Stop at the end of memory
+
+        read(eepromLocation + received, (uint8_t *)strToRead + received, amtToRead);
+
+        // Look for the terminator in this burst
+        for (uint16_t x = 0; x < amtToRead; x++)
+        {
+            if (strToRead[received + x] == '\0')
+                return (received + x);
+        }
+        received += amtToRead;
+    }
+
+    strToRead[received] = '\0';
+    return (received);
+}
+
+// Write a block of data preceded by its two byte length so it can be read back without scanning
+// The length is staged with the start of the data so a small blob costs a single page write.
+// Returns the location after the data
+uint32_t ExternalEEPROM::putBlob(uint32_t eepromLocation, const uint8_t *data, uint16_t length)
+{
+    uint8_t buff[I2C_BUFFER_LENGTH_TX];
+    uint16_t staged = getWriteChunkSize(eepromLocation, sizeof(length) + length);
+    if (staged < sizeof(length))
+        staged = sizeof(length); // The length straddles a page so it takes two writes regardless
+    memcpy(buff, &length, sizeof(length));
+    memcpy(buff + sizeof(length), data, staged - sizeof(length));
+    write(eepromLocation, buff, staged);
+
+    // The rest of the data goes straight from the caller's buffer
+    if (length > staged - sizeof(length))
+        write(eepromLocation + staged, data + staged - sizeof(length), length - (staged - sizeof(length)));
+    return (eepromLocation + sizeof(length) + length);
+}
+
+// Read a block written with putBlob() into a caller buffer
+// Returns the stored length. Only bufferSize bytes are copied if the stored block is larger.
+uint16_t ExternalEEPROM::getBlob(uint32_t eepromLocation, uint8_t *data, uint16_t bufferSize)
+{
+    uint16_t length = getBlobLength(eepromLocation);
+    uint16_t amtToRead = length;
+    if (amtToRead > bufferSize)
+        amtToRead = bufferSize;
+    read(eepromLocation + sizeof(length), data, amtToRead);
+    return (length);
+}
+
+// Return the length of a block written with putBlob()
+uint16_t ExternalEEPROM::getBlobLength(uint32_t eepromLocation)
+{
+    uint16_t length;
+    read(eepromLocation, (uint8_t *)&length, sizeof(length));
+    return (length);
+}
+
+// Compress a block and write it preceded by its original two byte length
+// Tokens are staged on the stack and sent a full page write at a time, so the number of write
+// cycles shrinks with the compressed size. Each chunk is compressed while the previous one programs.
+// Returns the location after the compressed data
+uint32_t ExternalEEPROM::putCompressed(uint32_t eepromLocation, const uint8_t *data, uint16_t length)
+{
+    // A write chunk is smaller than I2C_BUFFER_LENGTH_TX so after a flush there is always room for another token
+    uint8_t buff[I2C_BUFFER_LENGTH_TX * 2];
+    memcpy(buff, &length, sizeof(length));
+    uint16_t staged = sizeof(length);
+
+    uint32_t location = eepromLocation;
+    uint16_t position = 0;
+    while (true)
     {
-        tmp = read(eepromLocation);
-        if (tmp != 0)
+        staged += externalEEPROMLzCompress(data, length, position, buff + staged, sizeof(buff) - staged);
+
+        // Send every full chunk. A partial one waits for more tokens unless the data is done.
+        while (staged > 0)
         {
-            strToRead += static_cast<char>(tmp);
+            uint16_t amtToWrite = getWriteChunkSize(location, sizeof(buff));
+            if (amtToWrite > staged)
+            {
+                if (position < length)
+                    break;
+                amtToWrite = staged;
+            }
+
+            write(location, buff, amtToWrite);
+            location += amtToWrite;
+            staged -= amtToWrite;
+            memmove(buff, buff + amtToWrite, staged);
         }
-        eepromLocation++;
+
+        if (position == length && staged == 0)
+            break;
     }
+
+    return (location);
+}
+
+// Decompress a block written with putCompressed() into a caller buffer
+// The stream is decoded straight out of each I2C read. Back references are copied from data itself.
+// Returns the original length. Only bufferSize bytes are decoded if the original block is larger.
+// Returns 0 if the stored stream is corrupt.
+uint16_t ExternalEEPROM::getCompressed(uint32_t eepromLocation, uint8_t *data, uint16_t bufferSize)
+{
+    uint16_t length = getCompressedLength(eepromLocation);
+    uint16_t amtToDecode = length;
+    if (amtToDecode > bufferSize)
+        amtToDecode = bufferSize;
+
+    struct_lzDecoder decoder;
+    externalEEPROMLzBegin(decoder);
+
+    uint8_t buff[I2C_BUFFER_LENGTH_RX];
+    uint32_t location = eepromLocation + sizeof(length);
+    while (decoder.produced < amtToDecode && location < settings.memorySize_bytes)
+    {
+        // The stream can't be longer than the output left plus one token byte per literal run
+        uint32_t amtRemaining = amtToDecode - decoder.produced;
+        amtRemaining += amtRemaining / EXTERNAL_EEPROM_LZ_MAX_LITERALS + 2;
+        if (amtRemaining > settings.memorySize_bytes - location)
+            amtRemaining = settings.memorySize_bytes - location;
+
+        uint16_t amtToRead = getReadChunkSize(location, amtRemaining);
+        read(location, buff, amtToRead);
+        if (externalEEPROMLzDecompress(decoder, buff, amtToRead, data, amtToDecode) == false)
+            return (0);
+        location += amtToRead;
+    }
+
+    if (decoder.produced < amtToDecode)
+        return (0); // Ran off the end of memory
+    return (length);
 }
 
-// Assuming there are discrete EEPROM sizes, return the number of bytes in the next model
-uint32_t getNextSizeBytes(uint32_t currentSizeBytes)
+// Return the original length of a block written with putCompressed()
+uint16_t ExternalEEPROM::getCompressedLength(uint32_t eepromLocation)
 {
-    if (currentSizeBytes == 16)
-        return 128;                // 24LC00 - Lowest value
-    return (currentSizeBytes * 2); // 24LC01, 02, 04, 08, etc
+    return (getBlobLength(eepromLocation));
 }
 
 void ExternalEEPROM::setAddressBytes(uint8_t addressBytes)
@@ -427,14 +1151,8 @@ uint8_t ExternalEEPROM::detectAddressBytes()
     {
         setAddressBytes(addressBytes); // Start test at one byte
 
-        // Avoid the default state of 0xFF = 255 and 0. Assumes user has randomSeed()ed something.
-        // Do not use the original value
-        // Do not use the value found in the next location either
-        uint8_t magicValue = 0;
-        do
-        {
-            magicValue = random(1, 255); // (Inclusive, exclusive)
-        } while (magicValue == locationValueOriginal);
+        // The inverse of the original value can never be mistaken for it
+        uint8_t magicValue = ~locationValueOriginal;
 
         // Serial.print(" writing: 0x");
         // Serial.print(magicValue, HEX);
@@ -573,7 +1291,7 @@ uint16_t ExternalEEPROM::detectPageSizeBytes()
     return (settings.pageSize_bytes);
 }
 
-// Attempts write-then-reads until failure to determine memory bounds
+// Determines memory size from where addresses alias and which block select addresses answer
 // Identifies the following EEPROM types and their variants:
 // 24LC00 - 128 bit / 16 bytes - 1 address byte, 1 byte page size
 // 24LC01 - 1024 bit / 128 bytes - 1 address byte, 8 byte page size
@@ -586,138 +1304,190 @@ uint16_t ExternalEEPROM::detectPageSizeBytes()
 // 24LC128 - 131072 bit / 16384 bytes - 2 address bytes, 64 byte page size
 // 24LC256 - 262144 bit / 32768 bytes - 2 address bytes, 64 byte page size
 // 24LC512 - 524288 bit / 65536 bytes - 2 address bytes, 128 byte page size
-// 24LC1024 - 1024000 bit / 128000 byte - 2 address bytes, 128 byte page size
-// 24CM02 - 2097152 bit / 262144 byte - 2 address bytes, 256 byte page size
+// 24LC1025 - 1048576 bit / 131072 byte - 2 address bytes, 128 byte page size, block bit B0 in the A2 position
+// 24LC1026 - 1048576 bit / 131072 byte - 2 address bytes, 128 byte page size, block bit A16 in the A0 position
+// 24CM02 - 2097152 bit / 262144 byte - 2 address bytes, 256 byte page size, block bits A17/A16 in the A1/A0 positions
 // For EEPROMs of 4k, 8k, and 16k bit, there are three bits called
 // 'block select bits' inside the address byte that are used
 // For 32k, 64k, 128k, 256k, and 512k bit we need two address bytes
-// At 1Mbit (128,000 byte) and above there are two address bytes and a block select bit
-// is used but at the upper end of the address bits (so instead of A2/A1/A0 it's B0/A1/A0).
+// At 1Mbit and above there are two address bytes and block select bits in the device address
+//
+// Smaller EEPROMs ignore address bits beyond their size so location N of an N byte device is location 0.
+// We snapshot each candidate edge, write a single marker to location 0, and re-read the edges.
+// The first edge that changed is an alias of location 0 and is therefore the memory size.
+// The marker is the inverse of the original value so a change can't be a coincidence.
+// Block select devices are found by which block addresses answer. One write and one restore in total.
+// Note: other devices sharing block select addresses (ie, two 24xx512s at 0x50 and 0x51) look like one larger part.
 uint32_t ExternalEEPROM::detectMemorySizeBytes()
 {
-    // We do a read-write-read-write to test.
-    uint32_t testLocation = (128 / 8) - 1; // Start at the last spot of the smallest EEPROM
-    uint32_t lastGoodLocation = 0;
-
     // We can't run this test if we don't know the number of address bytes
     if (settings.addressSize_bytes == 0)
         detectAddressBytes();
 
-    // detectPageSizeBytes() calls this function so we cannot call it (endless loop)
-    // Because detectMemorySizeBytes() is only doing single byte writes, a page size of 1 is fine for now
-    if (settings.pageSize_bytes == 0)
-        settings.pageSize_bytes = 1;
-
-    // Determine if we are dealing with one or two byte addressing
-    uint8_t addressBytes = getAddressBytes();
-    if (addressBytes == 2)
-        testLocation = 4096 - 1; // Start test with 2-byte addresses
-    else
-        testLocation = 16 - 1; // Start test with 1-byte addresses
-
-    // Smaller EEPROMs ignore and set the address bits A7 through A10 to zero. This causes writes to wrap around.
-    // So to detect the edge of the usable space, we write to a location beyond the known edge of memory.
-    // If that same value is at the last known good edge of memory then we know the address is ignoring the address
-    // bit, it has wrapped the address, and we can infer the edge of memory.
+    waitForWriteComplete(); // A device still writing would NACK the block address checks
 
-    // 1 Read current value to preserve it
-    // 2 Read current value at next threshold
-    // 3 Write value to current spot
-    // 4 Check value at next threshold. If it was changed then we know the address we wrote was wrapped.
-    // 5 Return memory spot to its original value
+    // Candidate sizes, smallest first, and the device address/word address of the first byte past that size
+    const uint8_t maxCandidates = 6;
+    uint32_t candidateSize[maxCandidates];
+    uint8_t candidateI2CAddress[maxCandidates];
+    uint8_t candidateValue[maxCandidates];
+    uint8_t candidateCount = 0;
 
-    while (1)
+    if (getAddressBytes() == 1)
     {
-        // We must set our memory size to the next size up so that write sets the correct bits
-        uint32_t nextLocation = getNextSizeBytes(testLocation + 1) - 1;
-
-        // Serial.print("nextLocation: ");
-        // Serial.print(nextLocation);
-
-        setMemorySizeBytes(nextLocation + 1);
-
-        // Serial.print(" Test: ");
-        // Serial.print(nextLocation + 1);
-        // Serial.print(" bytes/");
-        // Serial.print((nextLocation + 1) * 8);
-        // Serial.print(" bits");
-        // Serial.print(", ");
-
-        // Read and store before we start (potentially) writing
-        uint8_t originalValue = read(testLocation);
-
-        // Serial.print("originalValue: 0x");
-        // Serial.print(originalValue, HEX);
-
-        uint8_t nextLocationOriginalValue = read(nextLocation);
-
-        // Serial.print(" nextLocationOriginalValue: 0x");
-        // Serial.print(nextLocationOriginalValue, HEX);
-        // Serial.print(" - ");
+        const uint32_t sizes[] = {16, 128, 256, 512, 1024};
+        for (uint8_t x = 0; x < sizeof(sizes) / sizeof(sizes[0]); x++)
+        {
+            candidateSize[candidateCount] = sizes[x];
+            candidateI2CAddress[candidateCount] = settings.deviceAddress | (sizes[x] >> 8); // Block bits A8 to A10
+            candidateCount++;
+        }
+    }
+    else
+    {
+        for (uint32_t size = 4096; size <= 32768; size *= 2)
+        {
+            candidateSize[candidateCount] = size;
+            candidateI2CAddress[candidateCount] = settings.deviceAddress;
+            candidateCount++;
+        }
+    }
 
-        // Avoid the default state of 0xFF = 255 and 0. Assumes user has randomSeed()ed something.
-        // Do not use the original value
-        // Do not use the value found in the next location either
-        uint8_t magicValue = random(1, 255); // (Inclusive, exclusive)
-        while (magicValue == originalValue && magicValue == nextLocationOriginalValue)
-            magicValue = random(1, 255); // (Inclusive, exclusive)
+    // 1 Read each candidate edge. A block address that doesn't answer ends the search.
+    uint8_t answeringCandidates = 0;
+    for (; answeringCandidates < candidateCount; answeringCandidates++)
+    {
+        if (isConnected(candidateI2CAddress[answeringCandidates]) == false)
+            break;
+        candidateValue[answeringCandidates] =
+            readByteAt(candidateI2CAddress[answeringCandidates], candidateSize[answeringCandidates]);
+    }
 
-        // Serial.print("writing: 0x");
-        // Serial.print(magicValue, HEX);
+    // 2 Write the inverse of the original value to location 0
+    uint8_t originalValue = readByteAt(settings.deviceAddress, 0);
+    writeByteAt(settings.deviceAddress, 0, ~originalValue);
 
-        // Write this new value to the edge of this block
-        write(testLocation, magicValue); // Will use a 1 or 2 byte address depending on setMemorySizeBytes()
+    // 3 The first edge that changed aliases location 0
+    uint32_t memorySize = 0;
+    for (uint8_t x = 0; x < answeringCandidates; x++)
+    {
+        if (readByteAt(candidateI2CAddress[x], candidateSize[x]) != candidateValue[x])
+        {
+            memorySize = candidateSize[x];
+            break;
+        }
+    }
+    if (memorySize == 0 && answeringCandidates < candidateCount)
+        memorySize = candidateSize[answeringCandidates]; // Stopped at a block address that didn't answer
+
+    // 4 Check the block select addresses of >512kbit EEPROMs
+    bool block1Answers = false; // A16 in the A0 position (24xx1026, 24xxM02)
+    bool block2Answers = false; // A17 in the A1 position (24xxM02)
+    bool block4Answers = false; // B0 in the A2 position (24xx1025)
+    if (memorySize == 0 && getAddressBytes() == 2)
+    {
+        // A block that changed with location 0 is an alias, not more memory
+        block1Answers = isBlockDistinct(settings.deviceAddress | 0b001, ~originalValue);
+        block2Answers = isBlockDistinct(settings.deviceAddress | 0b010, ~originalValue);
+        block4Answers = isBlockDistinct(settings.deviceAddress | 0b100, ~originalValue);
+    }
 
-        // Read back data
-        uint8_t newValue = read(testLocation);
+    // 5 Return location 0 to its original value
+    writeByteAt(settings.deviceAddress, 0, originalValue);
 
-        // Serial.print(" read: 0x");
-        // Serial.print(newValue, HEX);
-        // Serial.print(" - ");
+    if (memorySize == 0)
+    {
+        if (getAddressBytes() == 1)
+            memorySize = 2048; // Largest single address byte EEPROM
+        else if (block1Answers == true && block2Answers == true)
+        {
+            memorySize = 262144; // 24xxM02
+            settings.blockSelectShift = 0;
+        }
+        else if (block1Answers == true)
+        {
+            memorySize = 131072; // 24xx1026
+            settings.blockSelectShift = 0;
+        }
+        else if (block4Answers == true)
+        {
+            memorySize = 131072; // 24xx1025
+            settings.blockSelectShift = 2;
+        }
+        else
+            memorySize = 65536; // 24xx512
+    }
 
-        // Read data from the next spot before we return the original spot value
-        uint8_t nextNewValue = read(nextLocation);
+    settings.memorySize_bytes = memorySize;
 
-        // Serial.print("nextNewValue: 0x");
-        // Serial.print(nextNewValue, HEX);
-        // Serial.print(" - ");
+    // Serial.print("Memory size in bytes: ");
+    // Serial.println(settings.memorySize_bytes);
 
-        // Serial.println();
+    return (settings.memorySize_bytes);
+}
 
-        // Return spot to its original value
-        write(testLocation, originalValue);
+// Returns true if a block select address answers and its location 0 does not hold the marker just written
+// to the base address. Used during size detection.
+bool ExternalEEPROM::isBlockDistinct(uint8_t i2cAddress, uint8_t marker)
+{
+    if (isConnected(i2cAddress) == false)
+        return (false);
+    uint8_t before = readByteAt(i2cAddress, 0);
+    if (before != marker)
+        return (true);
 
-        lastGoodLocation = testLocation;
+    // Holds the marker. Rule out coincidence by changing the base again.
+    writeByteAt(settings.deviceAddress, 0, ~marker);
+    bool distinct = (readByteAt(i2cAddress, 0) == before);
+    writeByteAt(settings.deviceAddress, 0, marker);
+    return (distinct);
+}
 
-        // We should be able to write to all locations. But bail if we fail.
-        if (newValue != magicValue)
-        {
-            // Serial.println("\r\nWrite failed");
-            break;
-        }
+// Read one byte from an explicit device address and word address, ignoring the memory settings
+// Used during detection, before the block select arrangement is known
+uint8_t ExternalEEPROM::readByteAt(uint8_t i2cAddress, uint32_t wordAddress)
+{
+    waitForWriteComplete();
 
-        // We assume the address at the end of this memory space has changed,
-        // but if the address at the next level *also* changes, then we know the
-        // memory address has wrapped because the IC zeroes out the extra bits
-        else if (nextNewValue == magicValue)
-        {
-            // Serial.println("The write affected the next level - we're done!");
-            break;
-        }
+    sendAddress(i2cAddress, wordAddress);
+    transport->requestFrom(i2cAddress, (size_t)1);
+    countTransfer(0, 1, 0);
+    return (transport->read());
+}
 
-        if (testLocation >= (65536 * 2) - 1) // Limit to 512kBit
+// Write one byte to an explicit device address and word address and wait for it to complete
+void ExternalEEPROM::writeByteAt(uint8_t i2cAddress, uint32_t wordAddress, uint8_t dataToWrite)
+{
+    waitForWriteComplete();
+
+    if (settings.wpPin != 255)
+        digitalWrite(settings.wpPin, LOW);
+
+    transport->beginTransmission(i2cAddress);
+    if (settings.addressSize_bytes > 1)
+        transport->write((uint8_t)(wordAddress >> 8)); // MSB
+    transport->write((uint8_t)(wordAddress & 0xFF));   // LSB
+    transport->write(dataToWrite);
+    uint8_t result = transport->endTransmission();
+    countTransfer(settings.addressSize_bytes + 1, 0, result);
+#if EXTERNAL_EEPROM_STATS
+    if (result == 0)
+        stats.pageWrites++;
+#endif
+
+    unsigned long wait_us = micros();
+    for (uint8_t polls = 0; isBusy(settings.deviceAddress) == true; polls++)
+    {
+        countPoll();
+        if (backOff(wait_us, polls) == false)
             break;
-
-        // Move to next location
-        testLocation = nextLocation;
     }
+    endTiming(EXTERNAL_EEPROM_OP_WRITE_WAIT, wait_us);
 
-    settings.memorySize_bytes = lastGoodLocation + 1;
-
-    // Serial.print("Memory size in bytes: ");
-    // Serial.println(settings.memorySize_bytes);
+    if (settings.wpPin != 255)
+        digitalWrite(settings.wpPin, HIGH);
 
-    return (settings.memorySize_bytes);
+    invalidateReadCache(); // Detection writes go around the caches
 }
 
 // Read a byte from a given location
@@ -729,64 +1499,103 @@ uint8_t ExternalEEPROM::read(uint32_t eepromLocation)
 }
 
 // Bulk read from EEPROM
+// Data waiting in the write cache is returned in place of what is on the device
+int ExternalEEPROM::read(uint32_t eepromLocation, uint8_t *buff, uint16_t bufferSize)
+{
+    unsigned long start_us = startTiming();
+
+    if (writeCacheLineCount > 0)
+    {
+        // Serve reads that fall entirely inside a cached page without touching the bus
+        struct_writeCacheLine *line = findWriteCacheLine(eepromLocation);
+        if (line != nullptr && eepromLocation + bufferSize <= line->pageAddress + writeCacheLineSize)
+        {
+            memcpy(buff, getWriteCacheLineData(line) + (eepromLocation - line->pageAddress), bufferSize);
+            endTiming(EXTERNAL_EEPROM_OP_READ, start_us);
+            return (0);
+        }
+    }
+
+    int result;
+    if (readCacheBlockCount > 0)
+        result = readCached(eepromLocation, buff, bufferSize);
+    else
+        result = readBlock(eepromLocation, buff, bufferSize);
+
+    // Overlay data still waiting in the async write queue
+    if (asyncUsed > 0)
+        overlayAsyncWrites(eepromLocation, buff, bufferSize);
+
+    // Overlay any cached pages that overlap this read
+    for (uint8_t x = 0; x < writeCacheLineCount; x++)
+    {
+        struct_writeCacheLine *line = &writeCacheLines[x];
+        if (line->valid == false)
+            continue;
+        uint32_t start = line->pageAddress;
+        if (start < eepromLocation)
+            start = eepromLocation;
+        uint32_t end = line->pageAddress + writeCacheLineSize;
+        if (end > eepromLocation + bufferSize)
+            end = eepromLocation + bufferSize;
+        if (start < end)
+            memcpy(buff + (start - eepromLocation), getWriteCacheLineData(line) + (start - line->pageAddress),
+                   end - start);
+    }
+
+    endTiming(EXTERNAL_EEPROM_OP_READ, start_us);
+    return (result);
+}
+
+// Bulk read from the device, bypassing the write cache
 // Handles breaking up read amt into 32 byte chunks (can be overriden with setI2CBufferSize)
 // Handles a read that straddles the 512kbit barrier
-int ExternalEEPROM::read(uint32_t eepromLocation, uint8_t *buff, uint16_t bufferSize)
+int ExternalEEPROM::readBlock(uint32_t eepromLocation, uint8_t *buff, uint16_t bufferSize)
 {
     int result = 0;
 
     uint16_t received = 0;
     while (received < bufferSize)
     {
-        // Limit the amount to write to a page size
-        uint16_t amtToRead = bufferSize - received;
-        if (amtToRead > I2C_BUFFER_LENGTH_RX) // Arduino I2C buffer size limit
-            amtToRead = I2C_BUFFER_LENGTH_RX;
+        uint16_t amtToRead = getReadChunkSize(eepromLocation + received, bufferSize - received);
+        uint8_t i2cAddress = getI2CAddress(eepromLocation + received);
 
-        // Check if we are dealing with large (>512kbit) EEPROMs
-        uint8_t i2cAddress = settings.deviceAddress;
-        if (settings.memorySize_bytes > 0xFFFF)
+        bool heldOff = false;
+        if (settings.pollForWriteComplete == false)
+            waitForWriteComplete(); // Wait out whatever is left of the write time
+        else
+            heldOff = holdOffWriteCycle(); // Sleep through most of a page write instead of polling it
+
+        // Send the address, then read with a repeated start
+        // A device still busy with a page write NACKs the address, so the transfer itself is the ACK poll
+        unsigned long attempt_us = micros();
+        result = sendAddress(i2cAddress, eepromLocation + received);
+        if (result == 0 && heldOff == true)
+            learnWriteTime(attempt_us - lastPageWrite_us); // Finished by the end of the holdoff
+        if (result == 2)
         {
-            // Figure out if we are going to cross the barrier with this read
-            if (eepromLocation + received < 0xFFFF)
+            unsigned long wait_us = micros();
+            for (uint8_t polls = 0; result == 2; polls++)
             {
-                if (0xFFFF - (eepromLocation + received) < amtToRead) // 0xFFFF - 0xFFFA < 32
-                    amtToRead =
-                        0xFFFF - (eepromLocation + received); // Limit the read amt to go right up to edge of barrier
+                countRetry();
+                if (backOff(wait_us, polls) == false)
+                    break;
+                attempt_us = micros();
+                result = sendAddress(i2cAddress, eepromLocation + received);
             }
-
-            // Figure out if we are accessing the lower half or the upper half
-            if (eepromLocation + received > 0xFFFF)
-                i2cAddress |= 0b100; // Set the block bit to 1
-        }
-        // Check if we are dealing with 24LC04/08/16 (512, 1024, and 2048 bytes)
-        // These use a single address byte but change the I2C address
-        else if (settings.memorySize_bytes >= 512 && settings.memorySize_bytes <= 2048)
-        {
-            // Set I2C Address bits (A2/A1/A0) accordingly
-            i2cAddress |= ((eepromLocation + received) >> 8);
-        }
-
-        if (settings.pollForWriteComplete == false)
-        {
-            delay(settings.writeTime_ms);
+            endTiming(EXTERNAL_EEPROM_OP_WRITE_WAIT, wait_us);
+            if (result == 2)
+                return (EXTERNAL_EEPROM_TIMEOUT); // Still NACKing, so the device is missing or stuck
+            if (writeOutstanding == true)
+                learnWriteTime(attempt_us - lastPageWrite_us);
         }
+        writeOutstanding = false; // The device answered so it is not writing
 
-        // See if EEPROM is available or still writing a previous request
-        while (isBusy(settings.deviceAddress) == true) // Poll device's original address, not the modified one
-            delayMicroseconds(100); // This shortens the amount of time waiting between writes but hammers the I2C bus
-
-        settings.i2cPort->beginTransmission(i2cAddress);
-        if (settings.addressSize_bytes > 1)
-            settings.i2cPort->write((uint8_t)((eepromLocation + received) >> 8)); // MSB
-        settings.i2cPort->write((uint8_t)((eepromLocation + received) & 0xFF));   // LSB
-
-        result = settings.i2cPort->endTransmission();
-
-        settings.i2cPort->requestFrom((uint8_t)i2cAddress, (size_t)amtToRead);
+        transport->requestFrom((uint8_t)i2cAddress, (size_t)amtToRead);
+        countTransfer(0, amtToRead, 0);
 
         for (uint16_t x = 0; x < amtToRead; x++)
-            buff[received + x] = settings.i2cPort->read();
+            buff[received + x] = transport->read();
 
         received += amtToRead;
     }
@@ -794,21 +1603,88 @@ int ExternalEEPROM::read(uint32_t eepromLocation, uint8_t *buff, uint16_t buffer
     return (result);
 }
 
+// Return the number of bytes that can be read with one I2C read starting at eepromLocation
+// Limited by the I2C RX buffer, and on large (>512kbit) EEPROMs by the 64k block boundary
+uint16_t ExternalEEPROM::getReadChunkSize(uint32_t eepromLocation, uint32_t amtRemaining)
+{
+    uint16_t amtToRead = I2C_BUFFER_LENGTH_RX; // Arduino I2C buffer size limit
+    if (amtRemaining < amtToRead)
+        amtToRead = amtRemaining;
+
+    // Check if we are dealing with large (>512kbit) EEPROMs
+    if (settings.memorySize_bytes > 0xFFFF)
+    {
+        // Sequential reads wrap within a 64k block. Don't cross the barrier with this read.
+        uint32_t blockEnd = (eepromLocation | 0xFFFF) + 1;
+        if (eepromLocation + amtToRead > blockEnd)
+            amtToRead = blockEnd - eepromLocation; // Limit the read amt to go right up to edge of barrier
+    }
+    return (amtToRead);
+}
+
+// Read a region of any length one I2C read at a time, handing each burst to the callback
+// Each burst is the same one read() would make, drained into a single stack buffer of
+// I2C_BUFFER_LENGTH_RX bytes. TwoWire gives no access to its own buffer so this is the only copy.
+// Return false from the callback to stop early. Returns the number of bytes visited.
+uint32_t ExternalEEPROM::readVisit(uint32_t eepromLocation, uint32_t length,
+                                   bool (*callback)(uint32_t eepromLocation, const uint8_t *data, uint16_t length))
+{
+    if (eepromLocation >= settings.memorySize_bytes)
+        return (0);
+    if (eepromLocation + length > settings.memorySize_bytes)
+        length = settings.memorySize_bytes - eepromLocation;
+
+    uint8_t burst[I2C_BUFFER_LENGTH_RX];
+    uint32_t visited = 0;
+    while (visited < length)
+    {
+        uint16_t amtToRead = getReadChunkSize(eepromLocation + visited, length - visited);
+        read(eepromLocation + visited, burst, amtToRead); // Keeps the caches and queued writes in the picture
+        visited += amtToRead;
+        if (callback(eepromLocation + visited - amtToRead, burst, amtToRead) == false)
+            break;
+    }
+    return (visited);
+}
+
 // Write a byte to a given location
 int ExternalEEPROM::write(uint32_t eepromLocation, uint8_t dataToWrite)
 {
+    if (writeCacheLineCount > 0)
+        return (write(eepromLocation, &dataToWrite, 1)); // The cache programs whole pages so skip the compare
+
     if (read(eepromLocation) != dataToWrite) // Update only if data is new
         return (write(eepromLocation, &dataToWrite, 1));
     return (0);
 }
 
 // Write large bulk amounts
+// With the write cache enabled, data is merged into cached pages and recorded on flush
+int ExternalEEPROM::write(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t bufferSize)
+{
+    unsigned long start_us = startTiming();
+
+    int result;
+    if (writeCacheLineCount > 0)
+        result = writeCached(eepromLocation, dataToWrite, bufferSize);
+    else
+        result = writeBlock(eepromLocation, dataToWrite, bufferSize);
+
+    endTiming(EXTERNAL_EEPROM_OP_WRITE, start_us);
+    return (result);
+}
+
+// Write large bulk amounts directly to the device, bypassing the write cache
 // Limits writes to the I2C buffer size (default is 32 bytes)
 // Returns the result of the I2C endTransmission
-int ExternalEEPROM::write(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t bufferSize)
+int ExternalEEPROM::writeBlock(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t bufferSize)
 {
     int result = 0;
 
+    // Writes queued with writeAsync() must land first
+    if (asyncUsed > 0)
+        waitForAsyncWrites();
+
     // Error check
     if (eepromLocation + bufferSize >= settings.memorySize_bytes)
         bufferSize = settings.memorySize_bytes - eepromLocation;
@@ -816,91 +1692,1291 @@ int ExternalEEPROM::write(uint32_t eepromLocation, const uint8_t *dataToWrite, u
     // Serial.print("bufferSize: ");
     // Serial.println(bufferSize);
 
-    int16_t maxWriteSize = settings.pageSize_bytes;
-    if (maxWriteSize > I2C_BUFFER_LENGTH_TX - settings.addressSize_bytes)
-        maxWriteSize =
-            I2C_BUFFER_LENGTH_TX -
-            settings.addressSize_bytes; // Arduino has 32 byte limit. We loose 1 or 2 bytes to the EEPROM address
+    updateReadCache(eepromLocation, dataToWrite, bufferSize); // Keep cached blocks coherent with the device
 
-    // Serial.print("maxWriteSize: ");
-    // Serial.println(maxWriteSize);
+    lastVerifyStats.pagesVerified = 0;
+    lastVerifyStats.pagesRetried = 0;
+    lastVerifyStats.pagesFailed = 0;
 
     // Break the buffer into page sized chunks
     uint16_t recorded = 0;
     while (recorded < bufferSize)
     {
-        // Limit the amount to write to either the page size or the Arduino limit of 30
-        uint16_t amtToWrite = bufferSize - recorded;
+        uint16_t amtToWrite = getWriteChunkSize(eepromLocation + recorded, bufferSize - recorded);
+
+        int chunkResult = programPage(eepromLocation + recorded, dataToWrite + recorded, amtToWrite);
+        if (chunkResult == 0 && verifyWrites == true)
+            chunkResult = verifyPage(eepromLocation + recorded, dataToWrite + recorded, amtToWrite);
+        if (chunkResult != 0)
+            result = chunkResult; // Report a failed chunk even if later chunks succeed
+        if (chunkResult == EXTERNAL_EEPROM_TIMEOUT)
+            break; // No point waiting out the timeout for every page
+
+        recorded += amtToWrite;
+
+        // Serial.print("recorded: ");
+        // Serial.println(recorded);
 
-        // Serial.print("amtToWrite: ");
-        // Serial.println(amtToWrite);
+        if (wearCheckpointDue == true)
+            checkpointWear(); // Before a long write can overflow a one byte count
+    }
 
-        if (amtToWrite > (uint16_t)maxWriteSize)
-            amtToWrite = maxWriteSize;
+    return (result);
+}
 
-        // Serial.print("amtToWrite: ");
-        // Serial.println(amtToWrite);
+// Send one page write, waiting for the device as needed
+int ExternalEEPROM::programPage(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t amtToWrite)
+{
+    unsigned long start_us = startTiming();
 
-        if (amtToWrite > 1)
+    bool heldOff = false;
+    if (settings.pollForWriteComplete == false)
+        waitForWriteComplete(); // Wait out whatever is left of the write time
+    else
+        heldOff = holdOffWriteCycle(); // Sleep through most of the previous page write instead of polling it
+
+    // A device still busy with the previous page NACKs the address, so the page write itself is the ACK poll
+    unsigned long previousWrite_us = lastPageWrite_us; // Replaced once this page is accepted
+    bool previousOutstanding = writeOutstanding;
+    unsigned long attempt_us = micros();
+    int result = writePage(eepromLocation, dataToWrite, amtToWrite);
+    if (result == 0 && heldOff == true)
+        learnWriteTime(attempt_us - previousWrite_us); // Finished by the end of the holdoff
+    if (result == 2)
+    {
+        unsigned long wait_us = micros();
+        for (uint8_t polls = 0; result == 2; polls++)
         {
-            // Check for crossing of a page line. Writes cannot cross a page line.
-            uint16_t pageNumber1 = (eepromLocation + recorded) / settings.pageSize_bytes;
-            uint16_t pageNumber2 = (eepromLocation + recorded + amtToWrite - 1) / settings.pageSize_bytes;
-            if (pageNumber2 > pageNumber1)
-                amtToWrite = ((pageNumber1 + 1) * settings.pageSize_bytes) -
-                             (eepromLocation + recorded); // Limit the write amt to go right up to edge of page barrier
+            countRetry();
+            if (backOff(wait_us, polls) == false)
+                break;
+            attempt_us = micros();
+            result = writePage(eepromLocation, dataToWrite, amtToWrite);
         }
+        endTiming(EXTERNAL_EEPROM_OP_WRITE_WAIT, wait_us);
+        if (result == 2)
+            return (EXTERNAL_EEPROM_TIMEOUT); // Still NACKing, so the device is missing or stuck
+        if (previousOutstanding == true)
+            learnWriteTime(attempt_us - previousWrite_us);
+    }
+    endTiming(EXTERNAL_EEPROM_OP_PAGE_WRITE, start_us);
+
+    if (settings.pollForWriteComplete == false)
+    {
+        unsigned long wait_us = startTiming();
+        pollSleep(getWriteTimeLimitUs()); // Delay the amount of time to record a page
+        endTiming(EXTERNAL_EEPROM_OP_WRITE_WAIT, wait_us);
+        writeOutstanding = false;
+    }
+
+    return (result);
+}
+
+// Read a page write back once the device has finished it. Only this page is rewritten on a mismatch.
+// Returns EXTERNAL_EEPROM_VERIFY_FAILED if it still reads back wrong after verifyRetries rewrites, or the
+// read's error (ie, EXTERNAL_EEPROM_TIMEOUT) if the page could not be read back at all
+int ExternalEEPROM::verifyPage(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t amtToWrite)
+{
+    uint8_t readBack[I2C_BUFFER_LENGTH_TX];
 
-        uint8_t i2cAddress = settings.deviceAddress;
-        // Check if we are dealing with large (>512kbit) EEPROMs
-        // These use two address bytes and a B0 'block' bit
-        if (settings.memorySize_bytes > 0xFFFF)
+    for (uint8_t attempt = 0;; attempt++)
+    {
+        int result = readBlock(eepromLocation, readBack, amtToWrite); // Waits out the write cycle
+        if (result != 0)
+            return (result); // Nothing to compare. Rewriting the page would not help.
+        if (memcmp(readBack, dataToWrite, amtToWrite) == 0)
         {
-            // Figure out if we are accessing the lower half or the upper half
-            if (eepromLocation + recorded > 0xFFFF)
-                i2cAddress |= 0b100; // Set the block bit to 1
+            lastVerifyStats.pagesVerified++;
+            verifyStats.pagesVerified++;
+            if (attempt > 0)
+            {
+                lastVerifyStats.pagesRetried++;
+                verifyStats.pagesRetried++;
+            }
+            return (0);
         }
-        // Check if we are dealing with 24LC04/08/16 (512, 1024, and 2048 bytes)
-        // These use a single address byte but change the I2C address
-        else if (settings.memorySize_bytes >= 512 && settings.memorySize_bytes <= 2048)
+
+        if (attempt == verifyRetries)
         {
-            // Set I2C Address bits (A2/A1/A0) accordingly
-            i2cAddress |= ((eepromLocation + recorded) >> 8);
+            lastVerifyStats.pagesFailed++;
+            verifyStats.pagesFailed++;
+            return (EXTERNAL_EEPROM_VERIFY_FAILED);
         }
 
-        if (settings.pollForWriteComplete == false)
+        countRetry();
+        result = programPage(eepromLocation, dataToWrite, amtToWrite);
+        if (result != 0)
+            return (result);
+    }
+}
+
+// Read back every page write made by write()/put()/flush() and rewrite pages that don't match
+// Costs one read of each page after its write cycle. writeAsync() pages are not verified.
+void ExternalEEPROM::enableVerifyWrites(uint8_t maxRetries)
+{
+    verifyWrites = true;
+    verifyRetries = maxRetries;
+}
+
+void ExternalEEPROM::disableVerifyWrites()
+{
+    verifyWrites = false;
+}
+
+// Totals since the last resetVerifyStats()
+struct_verifyStats ExternalEEPROM::getVerifyStats()
+{
+    return (verifyStats);
+}
+
+// Totals for the most recent write to the device
+struct_verifyStats ExternalEEPROM::getLastWriteVerifyStats()
+{
+    return (lastVerifyStats);
+}
+
+void ExternalEEPROM::resetVerifyStats()
+{
+    verifyStats.pagesVerified = 0;
+    verifyStats.pagesRetried = 0;
+    verifyStats.pagesFailed = 0;
+}
+
+// Count every page write per page (or group of pagesPerCounter pages) to find pages nearing their rated endurance
+// RAM holds a one byte count per counter of writes since the last checkpoint. Totals live in a region of the
+// device: a 16 byte header then four bytes per counter (see getWearRegionSize()). Set the memory type first.
+// If the region already holds totals for the same layout they are kept, otherwise they start at zero.
+// The region is checkpointed once a counter reaches 192 writes, so a single hot page costs one extra page
+// write every 192. Those checkpoint writes are not themselves counted. Call checkpointWear() before power
+// down to keep the counts since the last checkpoint.
+bool ExternalEEPROM::enableWearTracking(uint32_t regionLocation, uint16_t pagesPerCounter)
+{
+    disableWearTracking();
+
+    if (pagesPerCounter == 0)
+        pagesPerCounter = 1;
+    uint32_t pageCount = (settings.memorySize_bytes + settings.pageSize_bytes - 1) / settings.pageSize_bytes;
+    uint32_t counterCount = (pageCount + pagesPerCounter - 1) / pagesPerCounter;
+    if (regionLocation + getWearRegionSize(pagesPerCounter) > settings.memorySize_bytes)
+        return (false);
+
+    wearDeltas = (uint8_t *)calloc(counterCount, 1);
+    if (wearDeltas == nullptr)
+        return (false);
+    wearCounterCount = counterCount;
+    wearPagesPerCounter = pagesPerCounter;
+    wearRegionLocation = regionLocation;
+
+    uint32_t header[wearHeaderSize / 4];
+    read(regionLocation, (uint8_t *)header, wearHeaderSize);
+    if (header[0] != wearMagic || header[1] != counterCount || header[2] != pagesPerCounter ||
+        header[3] != settings.pageSize_bytes)
+        resetWear(); // Nothing saved for this layout
+    return (true);
+}
+
+// Save the counts since the last checkpoint and release the table
+void ExternalEEPROM::disableWearTracking()
+{
+    if (wearDeltas == nullptr)
+        return;
+
+    checkpointWear();
+    free(wearDeltas);
+    wearDeltas = nullptr;
+    wearCounterCount = 0;
+}
+
+// Bytes of the device used to hold the wear totals
+uint32_t ExternalEEPROM::getWearRegionSize(uint16_t pagesPerCounter)
+{
+    if (pagesPerCounter == 0)
+        pagesPerCounter = 1;
+    uint32_t pageCount = (settings.memorySize_bytes + settings.pageSize_bytes - 1) / settings.pageSize_bytes;
+    return (wearHeaderSize + 4 * ((pageCount + pagesPerCounter - 1) / pagesPerCounter));
+}
+
+// Add the RAM counts to the totals on the device
+// Only the parts of the region whose counters changed are rewritten. The pages are programmed directly rather
+// than through writeBlock(), so a checkpoint taken in the middle of a write or an async queue does not wait on
+// the queue or disturb getLastWriteVerifyStats().
+void ExternalEEPROM::checkpointWear()
+{
+    if (wearDeltas == nullptr || wearCheckpointing == true)
+        return;
+    wearCheckpointing = true; // Checkpoint writes are not counted, or each one would need another
+    wearCheckpointDue = false;
+
+    uint32_t totals[I2C_BUFFER_LENGTH_TX / 4];
+    uint32_t counter = 0;
+    while (counter < wearCounterCount)
+    {
+        if (wearDeltas[counter] == 0)
         {
-            delay(settings.writeTime_ms);
+            counter++;
+            continue;
         }
 
-        // See if EEPROM is available or still writing a previous request
-        while (isBusy(settings.deviceAddress) == true) // Poll device's original address, not the modified one
-            delayMicroseconds(100); // This shortens the amount of time waiting between writes but hammers the I2C bus
+        // Update as many counters as one page write can hold
+        uint32_t location = wearRegionLocation + wearHeaderSize + counter * 4;
+        uint16_t amount = sizeof(totals) / 4;
+        if (amount > wearCounterCount - counter)
+            amount = wearCounterCount - counter;
+        amount = getWriteChunkSize(location, amount * 4) / 4;
+        if (amount == 0)
+            amount = 1; // Straddles a page
+
+        read(location, (uint8_t *)totals, amount * 4);
+        for (uint16_t x = 0; x < amount; x++)
+        {
+            totals[x] += wearDeltas[counter + x];
+            wearDeltas[counter + x] = 0;
+        }
+        updateReadCache(location, (const uint8_t *)totals, amount * 4);
+        uint16_t recorded = 0;
+        while (recorded < amount * 4)
+        {
+            uint16_t amtToWrite = getWriteChunkSize(location + recorded, amount * 4 - recorded);
+            programPage(location + recorded, (const uint8_t *)totals + recorded, amtToWrite);
+            recorded += amtToWrite;
+        }
+        counter += amount;
+    }
 
-        // Check if we are using Write Protection then disable WP for write access
-        if(settings.wpPin != 255 ) digitalWrite(settings.wpPin, LOW);
+    wearCheckpointing = false;
+}
 
-        settings.i2cPort->beginTransmission(i2cAddress);
-        if (settings.addressSize_bytes > 1) // Device larger than 16,384 bits have two byte addresses
-            settings.i2cPort->write((uint8_t)((eepromLocation + recorded) >> 8)); // MSB
-        settings.i2cPort->write((uint8_t)((eepromLocation + recorded) & 0xFF));   // LSB
+// Zero every total, in RAM and on the device
+void ExternalEEPROM::resetWear()
+{
+    if (wearDeltas == nullptr)
+        return;
+
+    wearCheckpointing = true;
+    memset(wearDeltas, 0, wearCounterCount);
+    uint32_t header[wearHeaderSize / 4] = {wearMagic, wearCounterCount, wearPagesPerCounter, settings.pageSize_bytes};
+    fill(wearRegionLocation + wearHeaderSize, wearCounterCount * 4, 0);
+    writeBlock(wearRegionLocation, (const uint8_t *)header, wearHeaderSize);
+    wearCheckpointing = false;
+}
 
-        for (uint16_t x = 0; x < amtToWrite; x++)
-            settings.i2cPort->write(dataToWrite[recorded + x]);
+// Total page writes to the page (or counter group) holding eepromLocation
+uint32_t ExternalEEPROM::getPageWear(uint32_t eepromLocation)
+{
+    if (wearDeltas == nullptr)
+        return (0);
+    uint32_t counter = eepromLocation / settings.pageSize_bytes / wearPagesPerCounter;
+    if (counter >= wearCounterCount)
+        return (0);
+
+    uint32_t total;
+    read(wearRegionLocation + wearHeaderSize + counter * 4, (uint8_t *)&total, sizeof(total));
+    return (total + wearDeltas[counter]);
+}
 
-        result = settings.i2cPort->endTransmission(); // Send stop condition
+// Find the most written pages. Fills up to maxCount locations (first byte of the page or group) and totals,
+// hottest first. Returns the number filled. The totals are read from the device one burst at a time.
+uint16_t ExternalEEPROM::getWearHottest(uint32_t *locations, uint32_t *totals, uint16_t maxCount)
+{
+    if (wearDeltas == nullptr)
+        return (0);
 
-        recorded += amtToWrite;
+    uint16_t found = 0;
+    uint32_t burst[I2C_BUFFER_LENGTH_RX / 4];
+    for (uint32_t counter = 0; counter < wearCounterCount; counter += sizeof(burst) / 4)
+    {
+        uint16_t amount = sizeof(burst) / 4;
+        if (amount > wearCounterCount - counter)
+            amount = wearCounterCount - counter;
+        read(wearRegionLocation + wearHeaderSize + counter * 4, (uint8_t *)burst, amount * 4);
 
-        // Serial.print("recorded: ");
-        // Serial.println(recorded);
+        for (uint16_t x = 0; x < amount; x++)
+        {
+            uint32_t total = burst[x] + wearDeltas[counter + x];
+            if (total == 0 || (found == maxCount && (found == 0 || total <= totals[found - 1])))
+                continue;
 
-        if (settings.pollForWriteComplete == false)
-            delay(settings.writeTime_ms); // Delay the amount of time to record a page
+            // Insertion into the sorted list, dropping the coolest entry when full
+            uint16_t slot = (found < maxCount) ? found++ : found - 1;
+            while (slot > 0 && totals[slot - 1] < total)
+            {
+                totals[slot] = totals[slot - 1];
+                locations[slot] = locations[slot - 1];
+                slot--;
+            }
+            totals[slot] = total;
+            locations[slot] = (counter + x) * wearPagesPerCounter * settings.pageSize_bytes;
+        }
+    }
+    return (found);
+}
+
+// Count the pages (or groups) in each wear band: buckets[n] counts totals from n * bucketWidth
+// to (n + 1) * bucketWidth - 1. The last bucket also holds everything above it.
+// Ie, 10 buckets of 100000 show how the part is spread over a 1M cycle rating.
+void ExternalEEPROM::getWearHistogram(uint32_t *buckets, uint8_t bucketCount, uint32_t bucketWidth)
+{
+    memset(buckets, 0, bucketCount * sizeof(uint32_t));
+    if (wearDeltas == nullptr || bucketCount == 0 || bucketWidth == 0)
+        return;
+
+    uint32_t burst[I2C_BUFFER_LENGTH_RX / 4];
+    for (uint32_t counter = 0; counter < wearCounterCount; counter += sizeof(burst) / 4)
+    {
+        uint16_t amount = sizeof(burst) / 4;
+        if (amount > wearCounterCount - counter)
+            amount = wearCounterCount - counter;
+        read(wearRegionLocation + wearHeaderSize + counter * 4, (uint8_t *)burst, amount * 4);
 
-        // Enable Write Protection if we are using WP
-        if(settings.wpPin != 255) digitalWrite(settings.wpPin, HIGH);
+        for (uint16_t x = 0; x < amount; x++)
+        {
+            uint32_t bucket = (burst[x] + wearDeltas[counter + x]) / bucketWidth;
+            if (bucket >= bucketCount)
+                bucket = bucketCount - 1;
+            buckets[bucket]++;
+        }
     }
+}
 
-    return (result);
+// Called for each page write the device accepts
+void ExternalEEPROM::countWear(uint32_t eepromLocation)
+{
+    uint32_t counter = eepromLocation / settings.pageSize_bytes / wearPagesPerCounter;
+    if (counter >= wearCounterCount)
+        return;
+    if (wearDeltas[counter] < 255)
+        wearDeltas[counter]++;
+    if (wearDeltas[counter] >= wearCheckpointThreshold)
+        wearCheckpointDue = true; // Saved once the current chunk is sent, or by update()
+}
+
+// Copy the bus and timing counters since the last resetStats()
+// Returns false, with the snapshot zeroed, if the library was built without EXTERNAL_EEPROM_STATS
+bool ExternalEEPROM::getStats(struct_eepromStats &snapshot)
+{
+#if EXTERNAL_EEPROM_STATS
+    snapshot = stats;
+    return (true);
+#else
+    memset(&snapshot, 0, sizeof(snapshot));
+    return (false);
+#endif
+}
+
+void ExternalEEPROM::resetStats()
+{
+#if EXTERNAL_EEPROM_STATS
+    memset(&stats, 0, sizeof(stats));
+#endif
+}
+
+// Count one I2C transfer. Any non-zero endTransmission() result is counted as a NACK.
+void ExternalEEPROM::countTransfer(uint16_t bytesOut, uint16_t bytesIn, uint8_t result)
+{
+#if EXTERNAL_EEPROM_STATS
+    stats.transactions++;
+    stats.bytesOut += bytesOut;
+    stats.bytesIn += bytesIn;
+    if (result != 0)
+        stats.nacks++;
+#else
+    (void)bytesOut;
+    (void)bytesIn;
+    (void)result;
+#endif
+}
+
+void ExternalEEPROM::countPoll()
+{
+#if EXTERNAL_EEPROM_STATS
+    stats.pollIterations++;
+#endif
+}
+
+void ExternalEEPROM::countRetry()
+{
+#if EXTERNAL_EEPROM_STATS
+    stats.retries++;
+#endif
+}
+
+// Without stats there is no need to read the clock
+unsigned long ExternalEEPROM::startTiming()
+{
+#if EXTERNAL_EEPROM_STATS
+    return (micros());
+#else
+    return (0);
+#endif
+}
+
+// Add the time since start_us to the operation's histogram. Bucket n holds times of n significant bits.
+void ExternalEEPROM::endTiming(uint8_t operation, unsigned long start_us)
+{
+#if EXTERNAL_EEPROM_STATS
+    uint32_t elapsed_us = micros() - start_us;
+    if (operation == EXTERNAL_EEPROM_OP_WRITE_WAIT)
+        stats.writeWait_us += elapsed_us;
+
+    uint8_t bucket = 0;
+    while (elapsed_us > 0 && bucket < EXTERNAL_EEPROM_LATENCY_BUCKETS - 1)
+    {
+        elapsed_us >>= 1;
+        bucket++;
+    }
+    stats.latency_us[operation][bucket]++;
+#else
+    (void)operation;
+    (void)start_us;
+#endif
+}
+
+// Wait for the last page write to this device to finish
+// Nothing is sent, and no time is spent, once the write time limit has passed since that write
+void ExternalEEPROM::waitForWriteComplete()
+{
+    if (writeOutstanding == false)
+        return;
+
+    unsigned long writeTime_us = getWriteTimeLimitUs();
+    unsigned long elapsed_us = micros() - lastPageWrite_us;
+    if (lastPageWriteAddress != settings.deviceAddress || elapsed_us >= writeTime_us)
+    {
+        writeOutstanding = false; // The write has finished, or was to another device
+        return;
+    }
+
+    unsigned long wait_us = startTiming();
+    if (settings.pollForWriteComplete == false)
+    {
+        // Only wait for what is left of the write time
+        pollSleep(writeTime_us - elapsed_us);
+    }
+    else
+    {
+        bool heldOff = holdOffWriteCycle();
+
+        unsigned long probe_us = micros();
+        unsigned long pollStart_us = probe_us;
+        bool wasBusy = false;
+        for (uint8_t polls = 0; isBusy(settings.deviceAddress) == true; polls++) // Poll device's original address
+        {
+            wasBusy = true;
+            countPoll();
+            if (backOff(pollStart_us, polls) == false)
+            {
+                endTiming(EXTERNAL_EEPROM_OP_WRITE_WAIT, wait_us);
+                return; // Give up on a device that has gone away. Its next transfer will time out too.
+            }
+            probe_us = micros();
+        }
+        if (wasBusy == true || heldOff == true)
+            learnWriteTime(probe_us - lastPageWrite_us);
+    }
+    endTiming(EXTERNAL_EEPROM_OP_WRITE_WAIT, wait_us);
+
+    writeOutstanding = false;
+}
+
+// Return the number of bytes that can be recorded with one page write starting at eepromLocation
+// Limited by the page size, the page boundary, and the I2C TX buffer
+uint16_t ExternalEEPROM::getWriteChunkSize(uint32_t eepromLocation, uint16_t amtRemaining)
+{
+    int16_t maxWriteSize = settings.pageSize_bytes;
+    if (maxWriteSize > I2C_BUFFER_LENGTH_TX - settings.addressSize_bytes)
+        maxWriteSize =
+            I2C_BUFFER_LENGTH_TX -
+            settings.addressSize_bytes; // Arduino has 32 byte limit. We loose 1 or 2 bytes to the EEPROM address
+
+    // Limit the amount to write to either the page size or the Arduino limit of 30
+    uint16_t amtToWrite = amtRemaining;
+    if (amtToWrite > (uint16_t)maxWriteSize)
+        amtToWrite = maxWriteSize;
+
+    if (amtToWrite > 1)
+    {
+        // Check for crossing of a page line. Writes cannot cross a page line.
+        uint32_t pageNumber1 = eepromLocation / settings.pageSize_bytes;
+        uint32_t pageNumber2 = (eepromLocation + amtToWrite - 1) / settings.pageSize_bytes;
+        if (pageNumber2 > pageNumber1)
+            amtToWrite = ((pageNumber1 + 1) * settings.pageSize_bytes) -
+                         eepromLocation; // Limit the write amt to go right up to edge of page barrier
+    }
+
+    return (amtToWrite);
+}
+
+// Return the I2C address to use for a given memory location
+// Larger and some smaller EEPROMs carry upper address bits in the device address
+uint8_t ExternalEEPROM::getI2CAddress(uint32_t eepromLocation)
+{
+    uint8_t i2cAddress = settings.deviceAddress;
+    // Check if we are dealing with large (>512kbit) EEPROMs
+    // These use two address bytes and one or two 'block' bits for A16/A17
+    if (settings.memorySize_bytes > 0xFFFF)
+    {
+        // Figure out which 64k block we are accessing
+        i2cAddress |= (eepromLocation >> 16) << settings.blockSelectShift;
+    }
+    // Check if we are dealing with 24LC04/08/16 (512, 1024, and 2048 bytes)
+    // These use a single address byte but change the I2C address
+    else if (settings.memorySize_bytes >= 512 && settings.memorySize_bytes <= 2048)
+    {
+        // Set I2C Address bits (A2/A1/A0) accordingly
+        i2cAddress |= (eepromLocation >> 8);
+    }
+    return (i2cAddress);
+}
+
+// Load the device's address counter without a stop condition, ready for a repeated start read
+// Returns the result of endTransmission(). 2 means the device NACKed (ie, it is busy writing).
+uint8_t ExternalEEPROM::sendAddress(uint8_t i2cAddress, uint32_t eepromLocation)
+{
+    transport->beginTransmission(i2cAddress);
+    if (settings.addressSize_bytes > 1)
+        transport->write((uint8_t)(eepromLocation >> 8)); // MSB
+    transport->write((uint8_t)(eepromLocation & 0xFF));   // LSB
+    uint8_t result = transport->endTransmission(false);
+    countTransfer(settings.addressSize_bytes, 0, result);
+    return (result);
+}
+
+// Send one page write without waiting for the device
+// The caller is responsible for the page boundary and for the device being ready
+int ExternalEEPROM::writePage(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t amtToWrite)
+{
+    // Check if we are using Write Protection then disable WP for write access
+    if (settings.wpPin != 255)
+        digitalWrite(settings.wpPin, LOW);
+
+    transport->beginTransmission(getI2CAddress(eepromLocation));
+    if (settings.addressSize_bytes > 1) // Device larger than 16,384 bits have two byte addresses
+        transport->write((uint8_t)(eepromLocation >> 8)); // MSB
+    transport->write((uint8_t)(eepromLocation & 0xFF));   // LSB
+
+    transport->write(dataToWrite, amtToWrite);
+
+    int result = transport->endTransmission(); // Send stop condition
+    countTransfer(settings.addressSize_bytes + amtToWrite, 0, result);
+
+    if (result == 0)
+    {
+#if EXTERNAL_EEPROM_STATS
+        stats.pageWrites++;
+#endif
+        if (wearDeltas != nullptr && wearCheckpointing == false)
+            countWear(eepromLocation);
+        lastPageWrite_us = micros();
+        lastPageWriteAddress = settings.deviceAddress;
+        writeOutstanding = true;
+    }
+
+    // Enable Write Protection if we are using WP
+    if (settings.wpPin != 255)
+        digitalWrite(settings.wpPin, HIGH);
+
+    return (result);
+}
+
+// Write the bytes that differ between newData and oldData
+// Runs of changed bytes within a page are merged, unchanged bytes included, as long as the merged span
+// still fits in one page write. Re-sending a few unchanged bytes is far cheaper than another write cycle.
+// Returns the result of the last failed I2C endTransmission, or 0
+int ExternalEEPROM::writeChanged(uint32_t eepromLocation, const uint8_t *newData, const uint8_t *oldData,
+                                 uint16_t bufferSize)
+{
+    int result = 0;
+    uint16_t bytesWritten = 0;
+    uint16_t cyclesUsed = 0;
+
+    uint16_t x = 0;
+    while (x < bufferSize)
+    {
+        // Find the start of the next changed span
+        while (x < bufferSize && newData[x] == oldData[x])
+            x++;
+        if (x == bufferSize)
+            break;
+
+        // Grow the span through the last changed byte that still fits in a single page write
+        uint16_t spanStart = x;
+        uint16_t maxSpan = getWriteChunkSize(eepromLocation + spanStart, bufferSize - spanStart);
+        uint16_t spanEnd = spanStart + 1;
+        for (x = spanStart + 1; x < spanStart + maxSpan; x++)
+        {
+            if (newData[x] != oldData[x])
+                spanEnd = x + 1;
+        }
+        x = spanEnd;
+
+        int spanResult = write(eepromLocation + spanStart, newData + spanStart, spanEnd - spanStart);
+        if (spanResult != 0)
+            result = spanResult;
+
+        bytesWritten += spanEnd - spanStart;
+        cyclesUsed++;
+    }
+
+    // Compare against what put() would have cost
+    uint16_t putCycles = 0;
+    for (uint16_t recorded = 0; recorded < bufferSize;)
+    {
+        recorded += getWriteChunkSize(eepromLocation + recorded, bufferSize - recorded);
+        putCycles++;
+    }
+    changedBytesSaved += bufferSize - bytesWritten;
+    changedCyclesSaved += putCycles - cyclesUsed;
+
+    return (result);
+}
+
+uint32_t ExternalEEPROM::getChangedBytesSaved()
+{
+    return (changedBytesSaved);
+}
+uint32_t ExternalEEPROM::getChangedCyclesSaved()
+{
+    return (changedCyclesSaved);
+}
+void ExternalEEPROM::resetChangedStats()
+{
+    changedBytesSaved = 0;
+    changedCyclesSaved = 0;
+}
+
+// Enable a RAM write-back cache of numberOfLines pages
+// put()/write() calls are merged into cached pages and each page is recorded with one
+// page-aligned write on flush(), on eviction, or once it has been dirty for deadline_ms (see update())
+// A deadline of 0 disables the timed flush. Set the memory type/page size before enabling.
+// Returns false if the cache could not be allocated
+bool ExternalEEPROM::enableWriteCache(uint8_t numberOfLines, uint32_t deadline_ms)
+{
+    disableWriteCache();
+
+    if (numberOfLines == 0 || settings.pageSize_bytes == 0)
+        return (false);
+
+    writeCacheLines = (struct_writeCacheLine *)malloc(numberOfLines *
+                                                      (sizeof(struct_writeCacheLine) + settings.pageSize_bytes));
+    if (writeCacheLines == nullptr)
+        return (false);
+
+    writeCacheLineCount = numberOfLines;
+    writeCacheLineSize = settings.pageSize_bytes;
+    writeCacheDeadline_ms = deadline_ms;
+    writeCacheTick = 0;
+
+    for (uint8_t x = 0; x < writeCacheLineCount; x++)
+    {
+        writeCacheLines[x].valid = false;
+        writeCacheLines[x].dirty = false;
+    }
+    return (true);
+}
+
+// Flush anything pending and release the cache memory
+void ExternalEEPROM::disableWriteCache()
+{
+    if (writeCacheLines == nullptr)
+        return;
+
+    flush();
+    free(writeCacheLines);
+    writeCacheLines = nullptr;
+    writeCacheLineCount = 0;
+}
+
+// Record every dirty cached page to the device
+// Returns the result of the last I2C endTransmission that failed, or 0
+int ExternalEEPROM::flush()
+{
+    int result = 0;
+    for (uint8_t x = 0; x < writeCacheLineCount; x++)
+    {
+        int lineResult = flushWriteCacheLine(&writeCacheLines[x]);
+        if (lineResult != 0)
+            result = lineResult;
+    }
+    return (result);
+}
+
+// Call regularly (ie, from loop())
+// Sends the next page of any writeAsync() data, and records cached pages that have passed their deadline
+void ExternalEEPROM::update()
+{
+    updateAsyncWrite();
+
+    if (wearCheckpointDue == true)
+        checkpointWear();
+
+    if (writeCacheDeadline_ms == 0)
+        return;
+
+    for (uint8_t x = 0; x < writeCacheLineCount; x++)
+    {
+        struct_writeCacheLine *line = &writeCacheLines[x];
+        if (line->dirty == true && millis() - line->dirtySince_ms >= writeCacheDeadline_ms)
+            flushWriteCacheLine(line);
+    }
+}
+
+// Returns the number of cached pages that have not yet been recorded
+uint8_t ExternalEEPROM::getWriteCacheDirtyCount()
+{
+    uint8_t dirtyCount = 0;
+    for (uint8_t x = 0; x < writeCacheLineCount; x++)
+    {
+        if (writeCacheLines[x].dirty == true)
+            dirtyCount++;
+    }
+    return (dirtyCount);
+}
+
+// Merge data into the cache, one page at a time
+int ExternalEEPROM::writeCached(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t bufferSize)
+{
+    int result = 0;
+
+    // Error check
+    if (eepromLocation + bufferSize >= settings.memorySize_bytes)
+        bufferSize = settings.memorySize_bytes - eepromLocation;
+
+    uint16_t recorded = 0;
+    while (recorded < bufferSize)
+    {
+        uint32_t location = eepromLocation + recorded;
+        uint32_t pageAddress = location - (location % writeCacheLineSize);
+        uint16_t pageOffset = location - pageAddress;
+
+        uint16_t amtToWrite = bufferSize - recorded;
+        if (amtToWrite > writeCacheLineSize - pageOffset)
+            amtToWrite = writeCacheLineSize - pageOffset; // Limit the amount to the end of this page
+
+        struct_writeCacheLine *line = findWriteCacheLine(location);
+        if (line == nullptr)
+        {
+            if (amtToWrite == writeCacheLineSize)
+            {
+                // A full page gains nothing from the cache. Record it directly.
+                int pageResult = writeBlock(pageAddress, dataToWrite + recorded, amtToWrite);
+                if (pageResult != 0)
+                    result = pageResult;
+                recorded += amtToWrite;
+                continue;
+            }
+
+            line = allocateWriteCacheLine(pageAddress);
+
+            // Load the rest of the page so the flush can record the whole page in one go
+            readBlock(pageAddress, getWriteCacheLineData(line), writeCacheLineSize);
+            if (asyncUsed > 0) // Queued data is not on the device yet
+                overlayAsyncWrites(pageAddress, getWriteCacheLineData(line), writeCacheLineSize);
+        }
+
+        memcpy(getWriteCacheLineData(line) + pageOffset, dataToWrite + recorded, amtToWrite);
+        if (line->dirty == false)
+        {
+            line->dirty = true;
+            line->dirtySince_ms = millis();
+        }
+        line->lastUsed = ++writeCacheTick;
+
+        recorded += amtToWrite;
+    }
+
+    update(); // Record anything past its deadline
+
+    return (result);
+}
+
+// Return the valid line holding the page that contains eepromLocation, or nullptr
+ExternalEEPROM::struct_writeCacheLine *ExternalEEPROM::findWriteCacheLine(uint32_t eepromLocation)
+{
+    for (uint8_t x = 0; x < writeCacheLineCount; x++)
+    {
+        struct_writeCacheLine *line = &writeCacheLines[x];
+        if (line->valid == true && eepromLocation >= line->pageAddress &&
+            eepromLocation < line->pageAddress + writeCacheLineSize)
+            return (line);
+    }
+    return (nullptr);
+}
+
+// Claim an unused line, or record and reuse the least recently used one
+ExternalEEPROM::struct_writeCacheLine *ExternalEEPROM::allocateWriteCacheLine(uint32_t pageAddress)
+{
+    struct_writeCacheLine *victim = &writeCacheLines[0];
+    for (uint8_t x = 0; x < writeCacheLineCount; x++)
+    {
+        struct_writeCacheLine *line = &writeCacheLines[x];
+        if (line->valid == false)
+        {
+            victim = line;
+            break;
+        }
+        if ((uint16_t)(writeCacheTick - line->lastUsed) > (uint16_t)(writeCacheTick - victim->lastUsed))
+            victim = line;
+    }
+
+    flushWriteCacheLine(victim);
+
+    victim->pageAddress = pageAddress;
+    victim->valid = true;
+    victim->dirty = false;
+    victim->lastUsed = ++writeCacheTick;
+    return (victim);
+}
+
+// Line data is stored after the array of line descriptors
+uint8_t *ExternalEEPROM::getWriteCacheLineData(struct_writeCacheLine *line)
+{
+    uint8_t *dataStart = (uint8_t *)&writeCacheLines[writeCacheLineCount];
+    return (dataStart + (line - writeCacheLines) * writeCacheLineSize);
+}
+
+int ExternalEEPROM::flushWriteCacheLine(struct_writeCacheLine *line)
+{
+    if (line->dirty == false)
+        return (0);
+
+    line->dirty = false;
+    return (writeBlock(line->pageAddress, getWriteCacheLineData(line), writeCacheLineSize));
+}
+
+// Enable a RAM read cache of numberOfBlocks blocks
+// Each miss reads a full I2C_BUFFER_LENGTH_RX sized block so nearby reads are served from RAM.
+// When reads walk sequentially through memory, the next block is read ahead.
+// Returns false if the cache could not be allocated
+bool ExternalEEPROM::enableReadCache(uint8_t numberOfBlocks)
+{
+    disableReadCache();
+
+    if (numberOfBlocks == 0)
+        return (false);
+
+    readCacheBlocks =
+        (struct_readCacheBlock *)malloc(numberOfBlocks * (sizeof(struct_readCacheBlock) + I2C_BUFFER_LENGTH_RX));
+    if (readCacheBlocks == nullptr)
+        return (false);
+
+    readCacheBlockCount = numberOfBlocks;
+    readCacheTick = 0;
+    readCacheNextLocation = 0xFFFFFFFF;
+    for (uint8_t x = 0; x < readCacheBlockCount; x++)
+        readCacheBlocks[x].valid = false;
+
+    resetReadCacheStats();
+    return (true);
+}
+
+void ExternalEEPROM::disableReadCache()
+{
+    if (readCacheBlocks == nullptr)
+        return;
+
+    free(readCacheBlocks);
+    readCacheBlocks = nullptr;
+    readCacheBlockCount = 0;
+}
+
+// Drop all cached blocks. Needed only if the device is changed by something other than this library.
+void ExternalEEPROM::invalidateReadCache()
+{
+    for (uint8_t x = 0; x < readCacheBlockCount; x++)
+        readCacheBlocks[x].valid = false;
+}
+
+uint32_t ExternalEEPROM::getReadCacheHits()
+{
+    return (readCacheHits);
+}
+uint32_t ExternalEEPROM::getReadCacheMisses()
+{
+    return (readCacheMisses);
+}
+void ExternalEEPROM::resetReadCacheStats()
+{
+    readCacheHits = 0;
+    readCacheMisses = 0;
+}
+
+// Serve a read from cached blocks, loading blocks on a miss
+// Whole blocks that miss are read straight into the caller's buffer so bulk reads don't flush the cache
+int ExternalEEPROM::readCached(uint32_t eepromLocation, uint8_t *buff, uint16_t bufferSize)
+{
+    int result = 0;
+    bool sequential = (eepromLocation == readCacheNextLocation);
+    readCacheNextLocation = eepromLocation + bufferSize;
+
+    uint16_t received = 0;
+    while (received < bufferSize)
+    {
+        uint32_t location = eepromLocation + received;
+        uint32_t blockAddress = location - (location % I2C_BUFFER_LENGTH_RX);
+        uint16_t blockOffset = location - blockAddress;
+
+        uint16_t amtToRead = bufferSize - received;
+        if (amtToRead > I2C_BUFFER_LENGTH_RX - blockOffset)
+            amtToRead = I2C_BUFFER_LENGTH_RX - blockOffset; // Limit the amount to the end of this block
+
+        struct_readCacheBlock *block = findReadCacheBlock(blockAddress);
+        if (block != nullptr)
+        {
+            readCacheHits++;
+        }
+        else
+        {
+            readCacheMisses++;
+            if (amtToRead == I2C_BUFFER_LENGTH_RX)
+            {
+                result = readBlock(location, buff + received, amtToRead);
+                received += amtToRead;
+                continue;
+            }
+            block = loadReadCacheBlock(blockAddress);
+            if (block == nullptr)
+            {
+                result = readBlock(location, buff + received, amtToRead); // Report the error to the caller
+                received += amtToRead;
+                continue;
+            }
+        }
+
+        memcpy(buff + received, getReadCacheBlockData(block) + blockOffset, amtToRead);
+        block->lastUsed = ++readCacheTick;
+        received += amtToRead;
+    }
+
+    // Read ahead if the caller is walking through memory
+    if (sequential == true)
+    {
+        uint32_t nextBlockAddress = readCacheNextLocation - (readCacheNextLocation % I2C_BUFFER_LENGTH_RX);
+        if (nextBlockAddress < settings.memorySize_bytes && findReadCacheBlock(nextBlockAddress) == nullptr)
+            loadReadCacheBlock(nextBlockAddress);
+    }
+
+    return (result);
+}
+
+ExternalEEPROM::struct_readCacheBlock *ExternalEEPROM::findReadCacheBlock(uint32_t blockAddress)
+{
+    for (uint8_t x = 0; x < readCacheBlockCount; x++)
+    {
+        if (readCacheBlocks[x].valid == true && readCacheBlocks[x].blockAddress == blockAddress)
+            return (&readCacheBlocks[x]);
+    }
+    return (nullptr);
+}
+
+// Read a block into an unused or the least recently used slot
+// Returns nullptr if the device could not be read
+ExternalEEPROM::struct_readCacheBlock *ExternalEEPROM::loadReadCacheBlock(uint32_t blockAddress)
+{
+    struct_readCacheBlock *victim = &readCacheBlocks[0];
+    for (uint8_t x = 0; x < readCacheBlockCount; x++)
+    {
+        struct_readCacheBlock *block = &readCacheBlocks[x];
+        if (block->valid == false)
+        {
+            victim = block;
+            break;
+        }
+        if ((uint16_t)(readCacheTick - block->lastUsed) > (uint16_t)(readCacheTick - victim->lastUsed))
+            victim = block;
+    }
+
+    uint16_t blockSize = I2C_BUFFER_LENGTH_RX;
+    if (blockAddress + blockSize > settings.memorySize_bytes)
+        blockSize = settings.memorySize_bytes - blockAddress; // Last block of a small device
+
+    victim->valid = false;
+    if (readBlock(blockAddress, getReadCacheBlockData(victim), blockSize) != 0)
+        return (nullptr); // Don't cache whatever a failed read left behind
+    if (asyncUsed > 0) // Queued data is not on the device yet
+        overlayAsyncWrites(blockAddress, getReadCacheBlockData(victim), blockSize);
+
+    victim->blockAddress = blockAddress;
+    victim->valid = true;
+    victim->lastUsed = ++readCacheTick;
+    return (victim);
+}
+
+// Block data is stored after the array of block descriptors
+uint8_t *ExternalEEPROM::getReadCacheBlockData(struct_readCacheBlock *block)
+{
+    uint8_t *dataStart = (uint8_t *)&readCacheBlocks[readCacheBlockCount];
+    return (dataStart + (block - readCacheBlocks) * I2C_BUFFER_LENGTH_RX);
+}
+
+// Copy data being written to the device into any cached blocks it overlaps
+void ExternalEEPROM::updateReadCache(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t bufferSize)
+{
+    for (uint8_t x = 0; x < readCacheBlockCount; x++)
+    {
+        struct_readCacheBlock *block = &readCacheBlocks[x];
+        if (block->valid == false)
+            continue;
+
+        uint32_t start = block->blockAddress;
+        if (start < eepromLocation)
+            start = eepromLocation;
+        uint32_t end = block->blockAddress + I2C_BUFFER_LENGTH_RX;
+        if (end > eepromLocation + bufferSize)
+            end = eepromLocation + bufferSize;
+        if (start < end)
+            memcpy(getReadCacheBlockData(block) + (start - block->blockAddress), dataToWrite + (start - eepromLocation),
+                   end - start);
+    }
+}
+
+// Enable non-blocking writes through writeAsync()
+// bufferSize bytes are allocated to queue data. Each queued write also uses 6 bytes of the buffer.
+// Returns false if the queue could not be allocated
+bool ExternalEEPROM::enableAsyncWrite(uint16_t bufferSize)
+{
+    disableAsyncWrite();
+
+    asyncBuffer = (uint8_t *)malloc(bufferSize);
+    if (asyncBuffer == nullptr)
+        return (false);
+
+    asyncBufferSize = bufferSize;
+    asyncReadIndex = 0;
+    asyncUsed = 0;
+    asyncHeadRemaining = 0;
+    return (true);
+}
+
+// Finish anything queued and release the queue memory
+void ExternalEEPROM::disableAsyncWrite()
+{
+    if (asyncBuffer == nullptr)
+        return;
+
+    waitForAsyncWrites();
+    free(asyncBuffer);
+    asyncBuffer = nullptr;
+    asyncBufferSize = 0;
+}
+
+// Queue data to be written and return immediately. The data is copied so the caller may reuse its buffer.
+// Call update() regularly to record the data, one page write per call.
+// Returns false if there is not enough room in the queue; call update() and try again.
+bool ExternalEEPROM::writeAsync(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t bufferSize)
+{
+    // Error check
+    if (eepromLocation + bufferSize >= settings.memorySize_bytes)
+        bufferSize = settings.memorySize_bytes - eepromLocation;
+
+    if (bufferSize == 0)
+        return (true);
+
+    if ((uint32_t)asyncBufferSize - asyncUsed < (uint32_t)bufferSize + asyncHeaderSize)
+        return (false);
+
+    uint8_t header[asyncHeaderSize];
+    memcpy(header, &eepromLocation, sizeof(eepromLocation));
+    memcpy(header + sizeof(eepromLocation), &bufferSize, sizeof(bufferSize));
+    copyToAsyncBuffer(header, asyncHeaderSize);
+    copyToAsyncBuffer(dataToWrite, bufferSize);
+
+    // Cached copies now reflect the queued data
+    updateReadCache(eepromLocation, dataToWrite, bufferSize);
+    updateWriteCache(eepromLocation, dataToWrite, bufferSize);
+
+    return (true);
+}
+
+// Set a function to be called each time a queued write has been completely sent to the device
+// The callback receives the location and length passed to writeAsync() and the worst endTransmission() result
+void ExternalEEPROM::setAsyncWriteCallback(void (*callback)(uint32_t eepromLocation, uint16_t length, int result))
+{
+    asyncWriteCallback = callback;
+}
+
+// Returns the number of bytes still waiting to be sent to the device
+uint16_t ExternalEEPROM::getAsyncWritePending()
+{
+    uint16_t pending = asyncHeadRemaining;
+    uint16_t index = asyncReadIndex + asyncHeadRemaining;
+    uint16_t remaining = asyncUsed - asyncHeadRemaining;
+    while (remaining > 0)
+    {
+        uint32_t location;
+        uint16_t length;
+        readAsyncHeader(index, location, length);
+        pending += length;
+        index += asyncHeaderSize + length;
+        remaining -= asyncHeaderSize + length;
+    }
+    return (pending);
+}
+
+// Returns true when all queued data has been sent and the last page write has finished
+bool ExternalEEPROM::isAsyncWriteComplete()
+{
+    return (asyncUsed == 0 && isAsyncDeviceReady() == true);
+}
+
+// Block until every queued write has been recorded
+// Returns false if the device stopped accepting pages for longer than the poll timeout. The rest stays queued.
+bool ExternalEEPROM::waitForAsyncWrites()
+{
+    unsigned long wait_us = micros();
+    uint8_t polls = 0;
+    while (asyncUsed > 0)
+    {
+        if (updateAsyncWrite() == true)
+        {
+            wait_us = micros(); // Progress. The timeout and backoff start over.
+            polls = 0;
+        }
+        else if (backOff(wait_us, polls++) == false)
+            return (false);
+    }
+    return (true);
+}
+
+// Send the next page of queued data if the device has finished the previous one
+// Returns true if a page write was started
+bool ExternalEEPROM::updateAsyncWrite()
+{
+    if (asyncUsed == 0)
+        return (false);
+
+    // With polling, a busy device simply NACKs the page write below. Don't try before it is likely to have finished.
+    if (settings.pollForWriteComplete == false && isAsyncDeviceReady() == false)
+        return (false);
+    if (settings.pollForWriteComplete == true && isWriteCycleEarly() == true)
+        return (false);
+
+    // Load the next queued write
+    if (asyncHeadRemaining == 0)
+    {
+        readAsyncHeader(asyncReadIndex, asyncHeadLocation, asyncHeadRemaining);
+        consumeAsyncBuffer(asyncHeaderSize);
+        asyncHeadStart = asyncHeadLocation;
+        asyncHeadLength = asyncHeadRemaining;
+        asyncHeadResult = 0;
+    }
+
+    uint8_t pageData[I2C_BUFFER_LENGTH_TX];
+    uint16_t amtToWrite = getWriteChunkSize(asyncHeadLocation, asyncHeadRemaining);
+    for (uint16_t x = 0; x < amtToWrite; x++)
+        pageData[x] = asyncBuffer[(asyncReadIndex + x) % asyncBufferSize];
+
+    int result = writePage(asyncHeadLocation, pageData, amtToWrite);
+    if (result == 2)
+    {
+        countRetry();
+        return (false); // Still busy with the previous page. Try again on the next update().
+    }
+    if (result != 0)
+        asyncHeadResult = result;
+
+    consumeAsyncBuffer(amtToWrite);
+    asyncHeadLocation += amtToWrite;
+    asyncHeadRemaining -= amtToWrite;
+
+    if (wearCheckpointDue == true)
+        checkpointWear(); // waitForAsyncWrites() can send a whole queue without returning to update()
+
+    if (asyncHeadRemaining == 0 && asyncWriteCallback != nullptr)
+        asyncWriteCallback(asyncHeadStart, asyncHeadLength, asyncHeadResult);
+
+    return (true);
+}
+
+// Check if the device can accept another page without blocking
+bool ExternalEEPROM::isAsyncDeviceReady()
+{
+    if (writeOutstanding == false || micros() - lastPageWrite_us >= getWriteTimeLimitUs())
+        return (true);
+    if (settings.pollForWriteComplete == false)
+        return (false);
+    if (isWriteCycleEarly() == true)
+        return (false); // Not worth a poll yet
+    if (isBusy() == true)
+        return (false);
+    writeOutstanding = false;
+    return (true);
+}
+
+// Apply queued data, oldest first, to a buffer just read from the device
+void ExternalEEPROM::overlayAsyncWrites(uint32_t eepromLocation, uint8_t *buff, uint16_t bufferSize)
+{
+    uint32_t entryLocation = asyncHeadLocation;
+    uint16_t entryLength = asyncHeadRemaining;
+    uint16_t index = asyncReadIndex;
+    uint16_t remaining = asyncUsed;
+
+    while (1)
+    {
+        // Copy the overlapping part of this entry
+        uint32_t start = entryLocation;
+        if (start < eepromLocation)
+            start = eepromLocation;
+        uint32_t end = entryLocation + entryLength;
+        if (end > eepromLocation + bufferSize)
+            end = eepromLocation + bufferSize;
+        for (uint32_t x = start; x < end; x++)
+            buff[x - eepromLocation] = asyncBuffer[(index + (x - entryLocation)) % asyncBufferSize];
+
+        index += entryLength;
+        remaining -= entryLength;
+        if (remaining == 0)
+            break;
+
+        readAsyncHeader(index, entryLocation, entryLength);
+        index += asyncHeaderSize;
+        remaining -= asyncHeaderSize;
+    }
+}
+
+void ExternalEEPROM::copyToAsyncBuffer(const uint8_t *data, uint16_t length)
+{
+    uint16_t writeIndex = (asyncReadIndex + asyncUsed) % asyncBufferSize;
+    for (uint16_t x = 0; x < length; x++)
+    {
+        asyncBuffer[writeIndex++] = data[x];
+        if (writeIndex == asyncBufferSize)
+            writeIndex = 0;
+    }
+    asyncUsed += length;
+}
+
+void ExternalEEPROM::consumeAsyncBuffer(uint16_t length)
+{
+    asyncReadIndex = (asyncReadIndex + length) % asyncBufferSize;
+    asyncUsed -= length;
+}
+
+void ExternalEEPROM::readAsyncHeader(uint16_t index, uint32_t &eepromLocation, uint16_t &length)
+{
+    uint8_t header[asyncHeaderSize];
+    for (uint8_t x = 0; x < asyncHeaderSize; x++)
+        header[x] = asyncBuffer[(index + x) % asyncBufferSize];
+    memcpy(&eepromLocation, header, sizeof(eepromLocation));
+    memcpy(&length, header + sizeof(eepromLocation), sizeof(length));
+}
+
+// Copy data into any write cache lines it overlaps
+void ExternalEEPROM::updateWriteCache(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t bufferSize)
+{
+    for (uint8_t x = 0; x < writeCacheLineCount; x++)
+    {
+        struct_writeCacheLine *line = &writeCacheLines[x];
+        if (line->valid == false)
+            continue;
+
+        uint32_t start = line->pageAddress;
+        if (start < eepromLocation)
+            start = eepromLocation;
+        uint32_t end = line->pageAddress + writeCacheLineSize;
+        if (end > eepromLocation + bufferSize)
+            end = eepromLocation + bufferSize;
+        if (start < end)
+            memcpy(getWriteCacheLineData(line) + (start - line->pageAddress), dataToWrite + (start - eepromLocation),
+                   end - start);
+    }
 }
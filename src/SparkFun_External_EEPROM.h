@@ -29,6 +29,10 @@
 #include "Arduino.h"
 #include "Wire.h"
 
+#include "SparkFun_External_EEPROM_CRC.h"
+#include "SparkFun_External_EEPROM_LZ.h"
+#include "SparkFun_External_EEPROM_Transport.h"
+
 #if defined(ARDUINO_ARCH_APOLLO3)
 
 #define I2C_BUFFER_LENGTH_RX                                                                                           \
@@ -124,6 +128,107 @@ struct struct_memorySettings
     bool pollForWriteComplete;
     uint8_t addressSize_bytes;
     uint8_t wpPin;
+    uint8_t blockSelectShift;
+};
+
+// write() results beyond the I2C endTransmission() codes (0 to 5)
+#define EXTERNAL_EEPROM_VERIFY_FAILED 16 // A page still read back wrong after the verify retries
+#define EXTERNAL_EEPROM_TIMEOUT 17       // The device NACKed for longer than the poll timeout (missing or stuck)
+
+enum externalEEPROMBackoff
+{
+    EXTERNAL_EEPROM_BACKOFF_FIXED,       // Every gap is interval_us
+    EXTERNAL_EEPROM_BACKOFF_STEPPED,     // Gaps grow by interval_us: 1x, 2x, 3x...
+    EXTERNAL_EEPROM_BACKOFF_EXPONENTIAL, // Gaps double: 1x, 2x, 4x...
+};
+
+struct struct_pollPolicy
+{
+    uint32_t holdoff_us;     // Sleep after a page write before the first poll. Replaced by the learned write time.
+    uint16_t interval_us;    // First gap between polls
+    uint16_t maxInterval_us; // Gaps stop growing here
+    uint8_t backoff;         // externalEEPROMBackoff
+    uint32_t timeout_us;     // Give up waiting after this long. 0 waits forever.
+};
+
+// Busy wait helpers shared by ExternalEEPROM and ExternalEEPROMT. yieldCallback may be nullptr to use delay().
+// externalEEPROMBackOff() sleeps before poll number pollCount of a wait that started at waitStart_us and
+// returns false, without sleeping, once the policy's timeout has passed.
+bool externalEEPROMBackOff(const struct_pollPolicy &policy, unsigned long waitStart_us, uint8_t pollCount,
+                           void (*yieldCallback)());
+void externalEEPROMPollSleep(uint32_t sleep_us, void (*yieldCallback)());
+
+struct struct_verifyStats
+{
+    uint32_t pagesVerified; // Page writes that read back correctly, including after a retry
+    uint32_t pagesRetried;  // Page writes that needed at least one rewrite
+    uint32_t pagesFailed;   // Page writes that never read back correctly
+};
+
+// Performance counters and latency histograms, off by default to save RAM and cycles.
+// They change the size of ExternalEEPROM, so enable them for the library and the sketch alike:
+// in the build flags (-DEXTERNAL_EEPROM_STATS=1) or by changing the default below.
+#ifndef EXTERNAL_EEPROM_STATS
+#define EXTERNAL_EEPROM_STATS 0
+#endif
+
+// Bucket 0 counts latencies under 1us, bucket n counts 2^(n-1) to 2^n - 1us. The last bucket holds everything longer.
+#ifndef EXTERNAL_EEPROM_LATENCY_BUCKETS
+#define EXTERNAL_EEPROM_LATENCY_BUCKETS 20
+#endif
+
+enum externalEEPROMOperation
+{
+    EXTERNAL_EEPROM_OP_READ,       // One read()/get() call
+    EXTERNAL_EEPROM_OP_WRITE,      // One write()/put() call
+    EXTERNAL_EEPROM_OP_PAGE_WRITE, // One page write, from the first attempt until the device has accepted it
+    EXTERNAL_EEPROM_OP_WRITE_WAIT, // One wait for a write cycle to finish, polled or blind
+    EXTERNAL_EEPROM_OP_COUNT,
+};
+
+struct struct_eepromStats
+{
+    uint32_t transactions;   // I2C transfers, including address-only polls. A read is an address write then a read.
+    uint32_t bytesOut;       // Bytes sent, including memory address bytes
+    uint32_t bytesIn;        // Bytes received
+    uint32_t pageWrites;     // Page writes the device accepted
+    uint32_t pollIterations; // isBusy() polls that found the device still writing
+    uint32_t writeWait_us;   // Time spent waiting for write cycles to finish
+    uint32_t nacks;          // Transfers the device did not acknowledge
+    uint32_t retries;        // Transfers sent again because the device was busy, plus page rewrites after a failed verify
+    uint32_t latency_us[EXTERNAL_EEPROM_OP_COUNT][EXTERNAL_EEPROM_LATENCY_BUCKETS]; // Histograms, see above
+};
+
+// Default transport: passes bus traffic straight through to a TwoWire port
+class ExternalEEPROMWireTransport : public ExternalEEPROMTransport
+{
+  public:
+    TwoWire *i2cPort = &Wire;
+
+    void beginTransmission(uint8_t i2cAddress)
+    {
+        i2cPort->beginTransmission(i2cAddress);
+    }
+    size_t write(uint8_t dataToWrite)
+    {
+        return (i2cPort->write(dataToWrite));
+    }
+    size_t write(const uint8_t *dataToWrite, size_t length)
+    {
+        return (i2cPort->write(dataToWrite, length));
+    }
+    uint8_t endTransmission(bool sendStop = true)
+    {
+        return (i2cPort->endTransmission(sendStop));
+    }
+    size_t requestFrom(uint8_t i2cAddress, size_t length)
+    {
+        return (i2cPort->requestFrom(i2cAddress, length));
+    }
+    int read()
+    {
+        return (i2cPort->read());
+    }
 };
 
 class ExternalEEPROM
@@ -135,10 +240,17 @@ class ExternalEEPROM
     int write(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t blockSize);
 
     bool begin(uint8_t deviceAddress = 0b1010000, TwoWire &wirePort = Wire, uint8_t WP = 255); // By default use the Wire port
+    bool begin(uint8_t deviceAddress, ExternalEEPROMTransport &transportPort,
+               uint8_t WP = 255); // Use an alternate bus driver or a simulated device
+    ExternalEEPROMTransport *getTransport();
 
     bool isConnected(uint8_t i2cAddress = 255);
     bool isBusy(uint8_t i2cAddress = 255);
     void erase(uint8_t toWrite = 0x00); // Erase the entire memory. Optional: write a given byte to each spot.
+    uint32_t fill(uint32_t eepromLocation, uint32_t length, uint8_t toWrite = 0x00,
+                  void (*progressCallback)(uint32_t bytesDone, uint32_t bytesTotal) = nullptr); // Skips blank pages
+    uint32_t getFillPagesSkipped();
+    uint32_t getFillPageWrites();
 
     // void settings(struct_memorySettings newSettings); //Set all the settings using the settings struct
 
@@ -149,7 +261,9 @@ class ExternalEEPROM
     uint32_t getMemorySize();                  // Depricated
     uint32_t length();                         // Return size of EEPROM in bytes
 
-    void setMemoryType(uint16_t typeNumber);      // Valid types: 00, 01, 02, 04, 08, 16, 32, 64, 128, 256, 512, 1025, 2048
+    void setMemoryType(uint16_t typeNumber);      // Valid types: 00, 01, 02, 04, 08, 16, 32, 64, 128, 256, 512, 1025, 1026, 2048
+    void setBlockSelectShift(uint8_t shift);      // Position of A16 in the I2C address of >512kbit EEPROMs
+    uint8_t getBlockSelectShift();
 
     uint8_t detectAddressBytes(); // Determine the number of address bytes, 1 or 2
     void setAddressBytes(uint8_t addressBytes);
@@ -167,9 +281,26 @@ class ExternalEEPROM
     void setPageWriteTime(uint8_t writeTimeMS); // Depricated
     uint8_t getPageWriteTime();                 // Depricated
 
+    // Adaptive write time, on by default. Page writes are timed as they are polled and the estimate replaces
+    // writeTime_ms: polling starts near the expected end of a write, and the blind delay (with polling
+    // disabled) becomes mean + 4 deviations. detectWriteTimeMs() also feeds the estimate.
+    void enableAdaptiveWriteTime();
+    void disableAdaptiveWriteTime();
+    void resetWriteTimeEstimate();
+    uint32_t getWriteTimeMeanUs();
+    uint32_t getWriteTimeDeviationUs();
+    uint16_t getWriteTimeSamples();
+    uint32_t getWriteTimeLimitUs(); // A page write is assumed done after this long
+    uint32_t getWriteHoldoffUs();   // Time after a page write before the first poll
+
     void enablePollForWriteComplete(); // Most EEPROMs all I2C polling of when a write has completed
+    void setPollPolicy(const struct_pollPolicy &policy); // Holdoff, backoff, and timeout of busy polling
+    struct_pollPolicy getPollPolicy();
+    void setPollYield(void (*yieldCallback)()); // Run other tasks while waiting on the device
     void disablePollForWriteComplete();
     constexpr uint16_t getI2CBufferSize(); // Return the size of the TX buffer
+    uint16_t getWriteChunkSize(uint32_t eepromLocation, uint16_t amtRemaining); // Bytes one page write can record
+    uint16_t getReadChunkSize(uint32_t eepromLocation, uint32_t amtRemaining);  // Bytes one I2C read can return
 
     // Functionality to 'get' and 'put' objects to and from EEPROM.
     template <typename T> T &get(uint32_t idx, T &t)
@@ -191,18 +322,184 @@ class ExternalEEPROM
       const uint8_t *newData = (const uint8_t *)&t;
       uint8_t oldData[sizeof(T)];
       read(idx, oldData, sizeof(T));  // Address, data, sizeOfData
-      for (uint16_t i = 0; i < sizeof(T); i++) {
-        if (oldData[i] != newData[i]) {
-          write(idx + i, newData[i]);
-        }
-      }
+      writeChanged(idx, newData, oldData, sizeof(T)); // At most one page write per touched page
       return t;
     }
 
-    uint32_t putString(uint32_t eepromLocation, String &strToWrite);
+    // Write only the bytes of newData that differ from oldData (what is currently on the device)
+    // Changed bytes are grouped into page-bounded spans so each touched page costs a single write cycle
+    int writeChanged(uint32_t eepromLocation, const uint8_t *newData, const uint8_t *oldData, uint16_t bufferSize);
+    uint32_t getChangedBytesSaved();  // Bytes putChanged() did not have to send, compared to put()
+    uint32_t getChangedCyclesSaved(); // Page writes putChanged() did not have to do, compared to put()
+    void resetChangedStats();
+
+    // Power-fail safe storage. Copies alternate between numberOfSlots (at least 2) page aligned slots.
+    // Each slot has a header (generation counter and CRCs) that is written after the data, so an
+    // interrupted write leaves the previous copy intact. getAtomic() returns the newest intact copy.
+    template <typename T> bool putAtomic(uint32_t idx, const T &t, uint8_t numberOfSlots = 2)
+    {
+        return (writeAtomic(idx, (const uint8_t *)&t, sizeof(T), numberOfSlots) == 0);
+    }
+    template <typename T> bool getAtomic(uint32_t idx, T &t, uint8_t numberOfSlots = 2)
+    {
+        return (readAtomic(idx, (uint8_t *)&t, sizeof(T), numberOfSlots));
+    }
+    int writeAtomic(uint32_t eepromLocation, const uint8_t *data, uint16_t length, uint8_t numberOfSlots = 2);
+    bool readAtomic(uint32_t eepromLocation, uint8_t *data, uint16_t length, uint8_t numberOfSlots = 2);
+    uint32_t getAtomicSize(uint16_t length, uint8_t numberOfSlots = 2); // Bytes of memory used by the slots
+    uint32_t getAtomicGeneration(); // Generation of the last copy written or read, 0 if none
+
+    // Stream a region of any size to a callback one I2C read at a time (ie, to SD, Serial, or a hash)
+    uint32_t readVisit(uint32_t eepromLocation, uint32_t length,
+                       bool (*callback)(uint32_t eepromLocation, const uint8_t *data, uint16_t length));
+
+    // Check a region of the device without copying it to RAM. See SparkFun_External_EEPROM_CRC.h for the kernels.
+    uint32_t crc32(uint32_t eepromLocation, uint32_t length); // CRC-32 (IEEE 802.3 / zlib)
+    uint16_t crc16(uint32_t eepromLocation, uint32_t length); // CRC-16/CCITT-FALSE
+    bool verify(uint32_t eepromLocation, const uint8_t *data, uint32_t length); // True if the device matches data
+
+    uint32_t putString(uint32_t eepromLocation, const String &strToWrite);
+    uint32_t putString(uint32_t eepromLocation, const char *strToWrite);
     void getString(uint32_t eepromLocation, String &strToRead);
+    uint16_t getString(uint32_t eepromLocation, char *strToRead, uint16_t bufferSize); // Returns the string length
+
+    // Length prefixed blocks. The size is stored on the device so reads need no terminator scan.
+    uint32_t putBlob(uint32_t eepromLocation, const uint8_t *data, uint16_t length); // Returns the next free location
+    uint16_t getBlob(uint32_t eepromLocation, uint8_t *data, uint16_t bufferSize);  // Returns the stored length
+    uint16_t getBlobLength(uint32_t eepromLocation);
+
+    // Length prefixed blocks stored with the LZ codec in SparkFun_External_EEPROM_LZ.h. Tables and text
+    // take fewer bytes on the device and fewer write cycles. Decoding needs no RAM beyond one I2C read.
+    // Data that doesn't compress grows by about 2%.
+    uint32_t putCompressed(uint32_t eepromLocation, const uint8_t *data, uint16_t length); // Returns the next free location
+    uint16_t getCompressed(uint32_t eepromLocation, uint8_t *data, uint16_t bufferSize); // Returns the original length, 0 if corrupt
+    uint16_t getCompressedLength(uint32_t eepromLocation); // Original length
+
+    // Read back each page after it is written and rewrite only pages that don't match
+    void enableVerifyWrites(uint8_t maxRetries = 2);
+    void disableVerifyWrites();
+    struct_verifyStats getVerifyStats();          // Cumulative
+    struct_verifyStats getLastWriteVerifyStats(); // Most recent write to the device
+    void resetVerifyStats();
+
+    // Per-page endurance tracking. Totals are kept in a reserved region of the device.
+    bool enableWearTracking(uint32_t regionLocation, uint16_t pagesPerCounter = 1); // One RAM byte per counter
+    void disableWearTracking();                                       // Checkpoints and frees the table
+    uint32_t getWearRegionSize(uint16_t pagesPerCounter = 1);          // Bytes the region needs
+    void checkpointWear();                                            // Save the counts held in RAM
+    void resetWear();
+    uint32_t getPageWear(uint32_t eepromLocation); // Page writes to the page holding eepromLocation
+    uint16_t getWearHottest(uint32_t *locations, uint32_t *totals, uint16_t maxCount);
+    void getWearHistogram(uint32_t *buckets, uint8_t bucketCount, uint32_t bucketWidth);
+
+    // Bus and timing counters. Only kept when built with EXTERNAL_EEPROM_STATS.
+    bool getStats(struct_eepromStats &snapshot); // Copies the counters. False (and zeros) without EXTERNAL_EEPROM_STATS.
+    void resetStats();
+
+    // Write-back page cache. Small put()/write() calls that share a page are recorded with one page write.
+    bool enableWriteCache(uint8_t numberOfLines = 4, uint32_t deadline_ms = 0); // Allocates numberOfLines pages
+    void disableWriteCache(); // Flushes and frees the cache
+    int flush();              // Record all cached pages to the device
+    void update();            // Call from loop() to advance async writes and record cached pages past their deadline
+    uint8_t getWriteCacheDirtyCount();
+
+    // Read cache. Repeated small reads and get() calls are served from RAM instead of the bus.
+    bool enableReadCache(uint8_t numberOfBlocks = 4); // Allocates numberOfBlocks blocks of I2C_BUFFER_LENGTH_RX
+    void disableReadCache();
+    void invalidateReadCache();
+    uint32_t getReadCacheHits();
+    uint32_t getReadCacheMisses();
+    void resetReadCacheStats();
+
+    // Non-blocking writes. Data is queued and recorded one page at a time by update().
+    bool enableAsyncWrite(uint16_t bufferSize = 256); // Allocates the queue
+    void disableAsyncWrite();                         // Waits for queued data then frees the queue
+    bool writeAsync(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t bufferSize); // False if queue is full
+    template <typename T> bool putAsync(uint32_t idx, const T &t)
+    {
+        return (writeAsync(idx, (const uint8_t *)&t, sizeof(T)));
+    }
+    void setAsyncWriteCallback(void (*callback)(uint32_t eepromLocation, uint16_t length, int result));
+    uint16_t getAsyncWritePending(); // Bytes not yet sent to the device
+    bool isAsyncWriteComplete();     // True when the queue is empty and the device has finished writing
+    bool waitForAsyncWrites();       // Block until the queue is empty. False on a poll timeout.
 
   private:
+    struct struct_writeCacheLine
+    {
+        uint32_t pageAddress;        // Location of the first byte of the cached page
+        unsigned long dirtySince_ms; // millis() when the line was first modified since its last flush
+        uint16_t lastUsed;           // writeCacheTick of the last access, for LRU eviction
+        bool valid;
+        bool dirty;
+    };
+
+    struct struct_atomicHeader
+    {
+        uint32_t generation; // Incremented with every putAtomic()
+        uint32_t length;     // Size of the stored object
+        uint32_t dataCrc;
+        uint32_t headerCrc; // Covers the fields above
+    };
+
+    struct struct_readCacheBlock
+    {
+        uint32_t blockAddress; // Location of the first byte of the cached block
+        uint16_t lastUsed;     // readCacheTick of the last access, for LRU eviction
+        bool valid;
+    };
+
+    int readBlock(uint32_t eepromLocation, uint8_t *buff, uint16_t bufferSize);
+    int writeBlock(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t bufferSize);
+    uint8_t getI2CAddress(uint32_t eepromLocation);
+    int writePage(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t amtToWrite);
+    int programPage(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t amtToWrite);
+    int verifyPage(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t amtToWrite);
+    uint8_t sendAddress(uint8_t i2cAddress, uint32_t eepromLocation);
+    uint8_t readByteAt(uint8_t i2cAddress, uint32_t wordAddress);
+    void writeByteAt(uint8_t i2cAddress, uint32_t wordAddress, uint8_t dataToWrite);
+    bool isBlockDistinct(uint8_t i2cAddress, uint8_t marker);
+    void waitForWriteComplete();
+    void countWear(uint32_t eepromLocation);
+    void learnWriteTime(uint32_t writeTime_us);
+    void addWriteTimeSample(uint32_t writeTime_us);
+    bool isWriteCycleEarly();
+    bool holdOffWriteCycle();
+    bool backOff(unsigned long waitStart_us, uint8_t pollCount);
+    void pollSleep(uint32_t sleep_us);
+
+    // Stats hooks. They compile to nothing without EXTERNAL_EEPROM_STATS.
+    void countTransfer(uint16_t bytesOut, uint16_t bytesIn, uint8_t result);
+    void countPoll();
+    void countRetry();
+    unsigned long startTiming(); // micros(), or 0 without EXTERNAL_EEPROM_STATS
+    void endTiming(uint8_t operation, unsigned long start_us);
+
+    uint32_t getAtomicSlotSize(uint16_t length);
+    bool readAtomicHeader(uint32_t slotLocation, uint16_t length, struct_atomicHeader &header);
+    int8_t findAtomicSlot(uint32_t eepromLocation, uint16_t length, uint8_t numberOfSlots, uint8_t *buff,
+                          struct_atomicHeader &header, uint32_t &newestGeneration);
+
+    int writeCached(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t bufferSize);
+    struct_writeCacheLine *findWriteCacheLine(uint32_t eepromLocation);
+    struct_writeCacheLine *allocateWriteCacheLine(uint32_t pageAddress);
+    uint8_t *getWriteCacheLineData(struct_writeCacheLine *line);
+    int flushWriteCacheLine(struct_writeCacheLine *line);
+
+    int readCached(uint32_t eepromLocation, uint8_t *buff, uint16_t bufferSize);
+    struct_readCacheBlock *findReadCacheBlock(uint32_t blockAddress);
+    struct_readCacheBlock *loadReadCacheBlock(uint32_t blockAddress);
+    uint8_t *getReadCacheBlockData(struct_readCacheBlock *block);
+    void updateReadCache(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t bufferSize);
+    void updateWriteCache(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t bufferSize);
+
+    bool updateAsyncWrite();
+    bool isAsyncDeviceReady();
+    void overlayAsyncWrites(uint32_t eepromLocation, uint8_t *buff, uint16_t bufferSize);
+    void copyToAsyncBuffer(const uint8_t *data, uint16_t length);
+    void consumeAsyncBuffer(uint16_t length);
+    void readAsyncHeader(uint16_t index, uint32_t &eepromLocation, uint16_t &length);
+
     // Default settings are for onsemi CAT24C51 512Kbit I2C EEPROM used on SparkFun Qwiic EEPROM Breakout
     struct_memorySettings settings = {
         .i2cPort = &Wire,
@@ -214,7 +511,82 @@ class ExternalEEPROM
         .pollForWriteComplete = true,
         .addressSize_bytes = 2, // Default to two address bytes, to support 24xx32 / 4096 byte EEPROMs and larger
         .wpPin = 255, // By default, the write protection pin is not set
+        .blockSelectShift = 2, // >512kbit EEPROMs: A16 goes in the A2 position (24xx1025). 0 for 24xx1026/M02.
+    };
+
+    ExternalEEPROMWireTransport wireTransport;
+    ExternalEEPROMTransport *transport = &wireTransport; // All bus traffic goes through here
+
+    struct_writeCacheLine *writeCacheLines = nullptr; // Line descriptors followed by the page data
+    uint8_t writeCacheLineCount = 0;                  // 0 when the cache is disabled
+    uint16_t writeCacheLineSize = 0;
+    uint32_t writeCacheDeadline_ms = 0;
+    uint16_t writeCacheTick = 0;
+
+    struct_readCacheBlock *readCacheBlocks = nullptr; // Block descriptors followed by the block data
+    uint8_t readCacheBlockCount = 0;                  // 0 when the cache is disabled
+    uint16_t readCacheTick = 0;
+    uint32_t readCacheNextLocation = 0; // Where the next read would start if access is sequential
+    uint32_t readCacheHits = 0;
+    uint32_t readCacheMisses = 0;
+
+    static const uint8_t asyncHeaderSize = 6; // Location and length stored ahead of each queued write
+    uint8_t *asyncBuffer = nullptr;           // Ring of [location][length][data] entries
+    uint16_t asyncBufferSize = 0;
+    uint16_t asyncReadIndex = 0;     // Start of the unsent data of the entry being written
+    uint16_t asyncUsed = 0;          // Bytes in the ring, including the unsent part of the current entry
+    uint32_t asyncHeadLocation = 0;  // Next location to write for the current entry
+    uint16_t asyncHeadRemaining = 0; // Bytes of the current entry not yet sent
+    uint32_t asyncHeadStart = 0;     // Location and length of the current entry, for the callback
+    uint16_t asyncHeadLength = 0;
+    int asyncHeadResult = 0;
+    void (*asyncWriteCallback)(uint32_t eepromLocation, uint16_t length, int result) = nullptr;
+
+    unsigned long lastPageWrite_us = 0; // micros() of the last page write sent to the device
+    uint8_t lastPageWriteAddress = 0;   // Device that received it
+    bool writeOutstanding = false;      // True until that write is known to have finished
+
+    static const uint8_t writeTimeMinimumSamples = 4; // Use writeTime_ms until this many writes have been timed
+    bool adaptiveWriteTime = true;
+    uint16_t writeTimeSamples = 0;
+    uint32_t writeTimeMean_us = 0;
+    uint32_t writeTimeVariance = 0; // us squared
+
+    struct_pollPolicy pollPolicy = {
+        .holdoff_us = 0,
+        .interval_us = 100,
+        .maxInterval_us = 1000, // Keeps oversleeping the end of a write under 1ms
+        .backoff = EXTERNAL_EEPROM_BACKOFF_EXPONENTIAL,
+        .timeout_us = 50000, // Ten times the longest write time in datasheets
     };
+    void (*pollYield)() = nullptr;
+
+    uint32_t fillPagesSkipped = 0;
+    uint32_t fillPageWrites = 0;
+
+    uint32_t changedBytesSaved = 0;
+    uint32_t changedCyclesSaved = 0;
+
+    uint32_t atomicGeneration = 0;
+
+    static const uint32_t wearMagic = 0x52414557; // 'WEAR'
+    static const uint8_t wearHeaderSize = 16;     // Magic, counter count, pages per counter, page size
+    static const uint8_t wearCheckpointThreshold = 192;
+    uint8_t *wearDeltas = nullptr; // Page writes per counter since the last checkpoint
+    uint32_t wearCounterCount = 0;
+    uint16_t wearPagesPerCounter = 1;
+    uint32_t wearRegionLocation = 0;
+    bool wearCheckpointDue = false;
+    bool wearCheckpointing = false;
+
+    bool verifyWrites = false;
+    uint8_t verifyRetries = 2;
+    struct_verifyStats verifyStats = {};
+    struct_verifyStats lastVerifyStats = {};
+
+#if EXTERNAL_EEPROM_STATS
+    struct_eepromStats stats = {};
+#endif
 };
 
 #endif //_SPARKFUN_EXTERNAL_EEPROM_H
@@ -0,0 +1,213 @@
+/*
+  Several external EEPROMs presented as one address space.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#include "SparkFun_External_EEPROM_Array.h"
+
+bool ExternalEEPROMArray::addDevice(ExternalEEPROM &device)
+{
+    if (deviceCount == EXTERNAL_EEPROM_ARRAY_MAX_DEVICES)
+        return (false);
+    devices[deviceCount++] = &device;
+    return (true);
+}
+
+uint8_t ExternalEEPROMArray::getDeviceCount()
+{
+    return (deviceCount);
+}
+
+ExternalEEPROM *ExternalEEPROMArray::getDevice(uint8_t deviceNumber)
+{
+    if (deviceNumber >= deviceCount)
+        return (nullptr);
+    return (devices[deviceNumber]);
+}
+
+void ExternalEEPROMArray::setStripeSize(uint32_t stripeSize)
+{
+    this->stripeSize = stripeSize;
+}
+
+uint32_t ExternalEEPROMArray::getStripeSize()
+{
+    return (stripeSize);
+}
+
+uint32_t ExternalEEPROMArray::length()
+{
+    if (deviceCount == 0)
+        return (0);
+
+    if (stripeSize == 0)
+    {
+        uint32_t total = 0;
+        for (uint8_t x = 0; x < deviceCount; x++)
+            total += devices[x]->length();
+        return (total);
+    }
+
+    // Every device holds the same number of whole stripe units
+    uint32_t smallest = devices[0]->length();
+    for (uint8_t x = 1; x < deviceCount; x++)
+    {
+        if (devices[x]->length() < smallest)
+            smallest = devices[x]->length();
+    }
+    return ((smallest / stripeSize) * stripeSize * deviceCount);
+}
+
+uint8_t ExternalEEPROMArray::read(uint32_t eepromLocation)
+{
+    uint8_t tempByte;
+    read(eepromLocation, &tempByte, 1);
+    return tempByte;
+}
+
+// Each device's part of the range is read with as few calls as the mapping allows
+int ExternalEEPROMArray::read(uint32_t eepromLocation, uint8_t *buff, uint16_t bufferSize)
+{
+    int result = 0;
+
+    uint32_t arrayLength = length();
+    if (eepromLocation + bufferSize > arrayLength)
+        bufferSize = eepromLocation < arrayLength ? arrayLength - eepromLocation : 0;
+
+    uint16_t received = 0;
+    while (received < bufferSize)
+    {
+        uint32_t deviceLocation;
+        uint32_t runLength;
+        uint8_t deviceNumber = locate(eepromLocation + received, deviceLocation, runLength);
+
+        uint16_t amtToRead = bufferSize - received;
+        if (amtToRead > runLength)
+            amtToRead = runLength;
+
+        int readResult = devices[deviceNumber]->read(deviceLocation, buff + received, amtToRead);
+        if (readResult != 0)
+            result = readResult;
+        received += amtToRead;
+    }
+    return (result);
+}
+
+int ExternalEEPROMArray::write(uint32_t eepromLocation, uint8_t dataToWrite)
+{
+    uint32_t deviceLocation;
+    uint32_t runLength;
+    if (eepromLocation >= length())
+        return (0);
+    uint8_t deviceNumber = locate(eepromLocation, deviceLocation, runLength);
+    return (devices[deviceNumber]->write(deviceLocation, dataToWrite));
+}
+
+// Send one page write to each device in turn
+// Each device keeps a cursor to the next part of the range it holds. While one device is busy
+// recording its page, the others receive theirs, so write cycles run in parallel.
+// Returns the result of the last failed I2C endTransmission, or 0
+int ExternalEEPROMArray::write(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t bufferSize)
+{
+    int result = 0;
+
+    uint32_t arrayLength = length();
+    if (eepromLocation + bufferSize > arrayLength)
+        bufferSize = eepromLocation < arrayLength ? arrayLength - eepromLocation : 0;
+    uint32_t end = eepromLocation + bufferSize;
+
+    uint32_t cursor[EXTERNAL_EEPROM_ARRAY_MAX_DEVICES];
+    for (uint8_t x = 0; x < deviceCount; x++)
+        cursor[x] = getNextLocation(x, eepromLocation);
+
+    bool pending = true;
+    while (pending == true)
+    {
+        pending = false;
+        for (uint8_t x = 0; x < deviceCount; x++)
+        {
+            if (cursor[x] >= end)
+                continue;
+
+            uint32_t deviceLocation;
+            uint32_t runLength;
+            locate(cursor[x], deviceLocation, runLength);
+
+            uint16_t amtToWrite = end - cursor[x];
+            if (amtToWrite > runLength)
+                amtToWrite = runLength;
+            amtToWrite = devices[x]->getWriteChunkSize(deviceLocation, amtToWrite);
+
+            int writeResult = devices[x]->write(deviceLocation, dataToWrite + (cursor[x] - eepromLocation), amtToWrite);
+            if (writeResult != 0)
+                result = writeResult;
+
+            cursor[x] = getNextLocation(x, cursor[x] + amtToWrite);
+            if (cursor[x] < end)
+                pending = true;
+        }
+    }
+    return (result);
+}
+
+uint8_t ExternalEEPROMArray::locate(uint32_t eepromLocation, uint32_t &deviceLocation, uint32_t &runLength)
+{
+    if (stripeSize == 0)
+    {
+        uint8_t deviceNumber = 0;
+        while (deviceNumber < deviceCount - 1 && eepromLocation >= devices[deviceNumber]->length())
+        {
+            eepromLocation -= devices[deviceNumber]->length();
+            deviceNumber++;
+        }
+        deviceLocation = eepromLocation;
+        runLength = devices[deviceNumber]->length() - eepromLocation;
+        return (deviceNumber);
+    }
+
+    uint32_t unit = eepromLocation / stripeSize;
+    uint32_t unitOffset = eepromLocation % stripeSize;
+    deviceLocation = (unit / deviceCount) * stripeSize + unitOffset;
+    runLength = stripeSize - unitOffset;
+    return (unit % deviceCount);
+}
+
+// Returns length() if the device holds nothing at or after eepromLocation
+uint32_t ExternalEEPROMArray::getNextLocation(uint8_t deviceNumber, uint32_t eepromLocation)
+{
+    uint32_t arrayLength = length();
+    if (eepromLocation >= arrayLength)
+        return (arrayLength);
+
+    if (stripeSize == 0)
+    {
+        uint32_t deviceStart = 0;
+        for (uint8_t x = 0; x < deviceNumber; x++)
+            deviceStart += devices[x]->length();
+
+        if (eepromLocation < deviceStart)
+            return (deviceStart);
+        if (eepromLocation >= deviceStart + devices[deviceNumber]->length())
+            return (arrayLength);
+        return (eepromLocation);
+    }
+
+    uint32_t unit = eepromLocation / stripeSize;
+    if (unit % deviceCount == deviceNumber)
+        return (eepromLocation);
+
+    // Start of the next unit that belongs to this device
+    uint32_t nextUnit = unit - (unit % deviceCount) + deviceNumber;
+    if (nextUnit < unit)
+        nextUnit += deviceCount;
+    uint32_t nextLocation = nextUnit * stripeSize;
+    if (nextLocation > arrayLength)
+        nextLocation = arrayLength;
+    return (nextLocation);
+}
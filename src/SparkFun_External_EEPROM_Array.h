@@ -0,0 +1,74 @@
+/*
+  Several external EEPROMs presented as one address space.
+
+  Each device is an ExternalEEPROM that has already been started with its own
+  address and Wire port (or transport), so chips can sit on different buses.
+  Devices are either concatenated (the default) or striped in units of
+  setStripeSize() bytes.
+
+  Large writes are scheduled round robin: one page write is sent to each chip
+  in turn, so the write cycle of one chip overlaps the transfers to the others.
+  With striping every large write spreads over all chips. With concatenation a
+  write only overlaps where it spans more than one chip.
+
+  Write cycle overlap relies on ACK polling (the default). With polling disabled
+  each device waits out its write time after every page.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#ifndef _SPARKFUN_EXTERNAL_EEPROM_ARRAY_H
+#define _SPARKFUN_EXTERNAL_EEPROM_ARRAY_H
+
+#include "SparkFun_External_EEPROM.h"
+
+#define EXTERNAL_EEPROM_ARRAY_MAX_DEVICES 8 // 0x50 to 0x57
+
+class ExternalEEPROMArray
+{
+  public:
+    bool addDevice(ExternalEEPROM &device); // Devices are mapped in the order they are added
+    uint8_t getDeviceCount();
+    ExternalEEPROM *getDevice(uint8_t deviceNumber);
+
+    // 0 concatenates devices (default). Otherwise consecutive units of stripeSize bytes go to consecutive devices.
+    // A stripe of one page gives the most write overlap. Striping uses the size of the smallest device.
+    void setStripeSize(uint32_t stripeSize);
+    uint32_t getStripeSize();
+
+    uint32_t length(); // Total bytes in the array
+
+    uint8_t read(uint32_t eepromLocation);
+    int read(uint32_t eepromLocation, uint8_t *buff, uint16_t bufferSize);
+    int write(uint32_t eepromLocation, uint8_t dataToWrite);
+    int write(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t bufferSize);
+
+    template <typename T> T &get(uint32_t idx, T &t)
+    {
+        read(idx, (uint8_t *)&t, sizeof(T));
+        return t;
+    }
+
+    template <typename T> const T &put(uint32_t idx, const T &t)
+    {
+        write(idx, (const uint8_t *)&t, sizeof(T));
+        return t;
+    }
+
+  private:
+    // Return the device holding eepromLocation, its location on that device, and how many
+    // bytes from there are contiguous on the device
+    uint8_t locate(uint32_t eepromLocation, uint32_t &deviceLocation, uint32_t &runLength);
+    uint32_t getNextLocation(uint8_t deviceNumber, uint32_t eepromLocation); // First location >= eepromLocation on the device
+
+    ExternalEEPROM *devices[EXTERNAL_EEPROM_ARRAY_MAX_DEVICES];
+    uint8_t deviceCount = 0;
+    uint32_t stripeSize = 0;
+};
+
+#endif //_SPARKFUN_EXTERNAL_EEPROM_ARRAY_H
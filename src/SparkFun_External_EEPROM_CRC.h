@@ -0,0 +1,43 @@
+/*
+  CRC kernels for the SparkFun External EEPROM library.
+
+  Used by ExternalEEPROM::crc32()/crc16() to check regions of the device, and by
+  the power-fail safe putAtomic() headers. The kernel is chosen at compile time
+  to trade flash for speed; on AVR the tables stay in flash (PROGMEM). Define
+  EXTERNAL_EEPROM_CRC_KERNEL before including the library (or in the build flags)
+  to override the default:
+
+    0 - Bitwise. No tables. Smallest and slowest.
+    1 - Nibble tables. 96 bytes of tables. Default on AVR.
+    2 - Byte tables. 1.5kB of tables. Default elsewhere.
+    4 - Slice-by-4 for CRC-32 (4kB), byte table for CRC-16. Fastest on 32-bit MCUs.
+
+  CRC-32 is IEEE 802.3 (zlib, reflected 0xEDB88320). Pass 0 to start, or a previous result to continue.
+  CRC-16 is CCITT-FALSE (0x1021, no reflection). Pass 0xFFFF to start, or a previous result to continue.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#ifndef _SPARKFUN_EXTERNAL_EEPROM_CRC_H
+#define _SPARKFUN_EXTERNAL_EEPROM_CRC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef EXTERNAL_EEPROM_CRC_KERNEL
+#if defined(__AVR__)
+#define EXTERNAL_EEPROM_CRC_KERNEL 1 // Keeps flash use small
+#else
+#define EXTERNAL_EEPROM_CRC_KERNEL 2
+#endif
+#endif
+
+uint32_t externalEEPROMCrc32(uint32_t crc, const uint8_t *data, size_t length);
+uint16_t externalEEPROMCrc16(uint16_t crc, const uint8_t *data, size_t length);
+
+#endif //_SPARKFUN_EXTERNAL_EEPROM_CRC_H
@@ -0,0 +1,639 @@
+/*
+  Key-value store for the SparkFun External EEPROM library.
+
+  Each half of the region starts with a header:
+    [magic][generation][CRC-32 of magic and generation][state]
+  state is 0xFF while a compaction is filling the half and 0x00 once it is complete.
+  Records follow the header:
+    [key length][type][value length][key][value][CRC-16 of everything before it]
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#include "SparkFun_External_EEPROM_KV.h"
+
+#define KV_MAGIC 0x3153564B // "KVS1"
+#define KV_HEADER_SIZE 16
+#define KV_HEADER_STATE 12 // Offset of the state byte
+
+#define KV_RECORD_HEADER_SIZE 4
+#define KV_RECORD_CRC_SIZE 2
+#define KV_RECORD_LIVE 0xA5
+#define KV_RECORD_TOMBSTONE 0x5A
+
+#define KV_ENTRY_EMPTY 0
+#define KV_ENTRY_LIVE 1
+#define KV_ENTRY_DELETED 2
+
+#define KV_HASH_SEED 2166136261UL // FNV-1a offset basis
+#define KV_HASH_PRIME 16777619UL
+
+// Sequential reader for the mount scan. The log is read in I2C buffer sized bursts.
+struct struct_kvReader
+{
+    ExternalEEPROM *eeprom;
+    uint32_t location; // Next location to read from the device
+    uint32_t end;
+    uint16_t position;
+    uint16_t length;
+    uint8_t buffer[I2C_BUFFER_LENGTH_RX];
+
+    bool next(uint8_t &value)
+    {
+        if (position == length)
+        {
+            if (location >= end)
+                return (false);
+            uint32_t amtToRead = end - location;
+            if (amtToRead > sizeof(buffer))
+                amtToRead = sizeof(buffer);
+            eeprom->read(location, buffer, amtToRead);
+            location += amtToRead;
+            length = amtToRead;
+            position = 0;
+        }
+        value = buffer[position++];
+        return (true);
+    }
+};
+
+bool ExternalEEPROMKV::begin(ExternalEEPROM &eeprom, uint32_t regionStart, uint32_t regionLength, uint16_t maxKeys)
+{
+    end();
+
+    this->eeprom = &eeprom;
+    pageSize = eeprom.getPageSizeBytes();
+
+    // Two page aligned halves
+    uint32_t regionEnd = regionStart + regionLength;
+    if (regionEnd > eeprom.length())
+        regionEnd = eeprom.length();
+    if (regionStart % pageSize != 0)
+        regionStart += pageSize - (regionStart % pageSize);
+    if (regionEnd <= regionStart)
+        return (false);
+    halfSize = (regionEnd - regionStart) / 2;
+    halfSize -= halfSize % pageSize;
+    if (halfSize <= KV_HEADER_SIZE)
+        return (false);
+    this->regionStart = regionStart;
+
+    // Keep the index at most 3/4 full
+    if (maxKeys == 0 || (uint32_t)maxKeys + maxKeys / 3 + 1 > 32768)
+        return (false); // The index size is 16 bits
+    this->maxKeys = maxKeys;
+    indexSize = 1;
+    while (indexSize < maxKeys + maxKeys / 3 + 1)
+        indexSize <<= 1;
+
+    index = (struct_kvEntry *)malloc(indexSize * sizeof(struct_kvEntry));
+    stageBuffer = (uint8_t *)malloc(pageSize);
+    if (index == nullptr || stageBuffer == nullptr)
+    {
+        end();
+        return (false);
+    }
+
+    if (mount() == false)
+    {
+        end();
+        return (false);
+    }
+    return (true);
+}
+
+void ExternalEEPROMKV::end()
+{
+    if (index != nullptr && stageBuffer != nullptr)
+    {
+        while (phase != KV_IDLE)
+            compactionStep();
+    }
+    free(index);
+    index = nullptr;
+    free(stageBuffer);
+    stageBuffer = nullptr;
+}
+
+// Erase both halves and start over with an empty, complete first half
+void ExternalEEPROMKV::format()
+{
+    eeprom->fill(regionStart, halfSize * 2, 0xFF);
+    writeHeader(0, 1, true);
+
+    clearIndex();
+    activeHalf = 0;
+    generation = 1;
+    appendLocation = regionStart + KV_HEADER_SIZE;
+}
+
+bool ExternalEEPROMKV::put(const char *key, const uint8_t *value, uint16_t valueLength)
+{
+    if (index == nullptr)
+        return (false);
+
+    size_t keyLength = strlen(key);
+    if (keyLength == 0 || keyLength > EXTERNAL_EEPROM_KV_MAX_KEY)
+        return (false);
+
+    uint32_t hash = hashKey(key, keyLength);
+    struct_kvEntry *entry = findEntry(hash);
+    if (entry != nullptr && entry->state != KV_ENTRY_EMPTY && isKeyAt(key, keyLength, entry->location) == false)
+        return (false); // A different key already has this hash
+
+    bool newEntry = (entry == nullptr || entry->state == KV_ENTRY_EMPTY);
+    if (makeRoom(getRecordSize(keyLength, valueLength), newEntry) == false)
+        return (false);
+
+    uint32_t location;
+    if (appendRecord(key, keyLength, value, valueLength, false, location) == false)
+        return (false);
+    return (indexRecord(hash, location, valueLength, keyLength, false));
+}
+
+// Read a value. valueLength, if given, is set to the stored length.
+// Returns false if the key doesn't exist. Values longer than bufferSize are truncated.
+bool ExternalEEPROMKV::get(const char *key, uint8_t *value, uint16_t bufferSize, uint16_t *valueLength)
+{
+    size_t keyLength = strlen(key);
+    struct_kvEntry *entry = findLiveKey(key, keyLength);
+    if (entry == nullptr)
+        return (false);
+
+    uint16_t amtToRead = entry->valueLength;
+    if (amtToRead > bufferSize)
+        amtToRead = bufferSize;
+    eeprom->read(entry->location + KV_RECORD_HEADER_SIZE + keyLength, value, amtToRead);
+
+    if (valueLength != nullptr)
+        *valueLength = entry->valueLength;
+    return (true);
+}
+
+// Append a tombstone for the key
+bool ExternalEEPROMKV::remove(const char *key)
+{
+    if (exists(key) == false)
+        return (false);
+
+    size_t keyLength = strlen(key);
+    uint32_t hash = hashKey(key, keyLength);
+    if (makeRoom(getRecordSize(keyLength, 0), false) == false)
+        return (false);
+
+    uint32_t location;
+    if (appendRecord(key, keyLength, nullptr, 0, true, location) == false)
+        return (false);
+    return (indexRecord(hash, location, 0, keyLength, true));
+}
+
+bool ExternalEEPROMKV::exists(const char *key)
+{
+    return (findLiveKey(key, strlen(key)) != nullptr);
+}
+
+uint16_t ExternalEEPROMKV::getValueLength(const char *key)
+{
+    struct_kvEntry *entry = findLiveKey(key, strlen(key));
+    if (entry == nullptr)
+        return (0);
+    return (entry->valueLength);
+}
+
+uint16_t ExternalEEPROMKV::getKeyCount()
+{
+    return (keyCount);
+}
+
+uint32_t ExternalEEPROMKV::getFreeBytes()
+{
+    return (getHalfStart(activeHalf) + halfSize - appendLocation);
+}
+
+uint32_t ExternalEEPROMKV::getLiveBytes()
+{
+    return (liveBytes);
+}
+
+// Erase one page or move one record of a compaction in progress
+void ExternalEEPROMKV::update()
+{
+    if (phase != KV_IDLE)
+        compactionStep();
+}
+
+bool ExternalEEPROMKV::compact()
+{
+    if (index == nullptr)
+        return (false);
+
+    if (phase == KV_IDLE)
+        startCompaction();
+    while (phase != KV_IDLE)
+        compactionStep();
+    return (true);
+}
+
+bool ExternalEEPROMKV::isCompacting()
+{
+    return (phase != KV_IDLE);
+}
+
+// Pick the newest valid half and rebuild the index from its log
+// If that half is an unfinished compaction, the half it was compacting from is replayed first
+// and the compaction carries on from update()
+bool ExternalEEPROMKV::mount()
+{
+    bool valid[2];
+    bool complete[2];
+    uint32_t halfGeneration[2];
+    for (uint8_t half = 0; half < 2; half++)
+    {
+        uint8_t header[KV_HEADER_SIZE];
+        eeprom->read(getHalfStart(half), header, sizeof(header));
+
+        uint32_t magic;
+        uint32_t crc;
+        memcpy(&magic, header, sizeof(magic));
+        memcpy(&halfGeneration[half], header + 4, sizeof(uint32_t));
+        memcpy(&crc, header + 8, sizeof(crc));
+        valid[half] = (magic == KV_MAGIC && crc == externalEEPROMCrc32(0, header, 8));
+        complete[half] = (header[KV_HEADER_STATE] == 0x00);
+    }
+
+    if (valid[0] == false && valid[1] == false)
+    {
+        format();
+        return (true);
+    }
+
+    uint8_t newest = 0;
+    if (valid[1] == true && (valid[0] == false || halfGeneration[1] > halfGeneration[0]))
+        newest = 1;
+    uint8_t other = 1 - newest;
+
+    clearIndex();
+    activeHalf = newest;
+    generation = halfGeneration[newest];
+
+    if (complete[newest] == false && valid[other] == true && halfGeneration[other] + 1 == halfGeneration[newest])
+    {
+        // Interrupted compaction
+        if (replay(other, false) == false)
+            return (false);
+        if (replay(newest, true) == false)
+            return (false);
+        oldHalf = other;
+        copyIndex = 0;
+        phase = KV_COPYING;
+        return (true);
+    }
+
+    return (replay(newest, true));
+}
+
+// Add every intact record of a half to the index, reading the log sequentially
+bool ExternalEEPROMKV::replay(uint8_t half, bool lastHalf)
+{
+    uint32_t halfEnd = getHalfStart(half) + halfSize;
+    uint32_t recordLocation = getHalfStart(half) + KV_HEADER_SIZE;
+
+    struct_kvReader reader;
+    reader.eeprom = eeprom;
+    reader.location = recordLocation;
+    reader.end = halfEnd;
+    reader.position = 0;
+    reader.length = 0;
+
+    while (true)
+    {
+        uint8_t header[KV_RECORD_HEADER_SIZE];
+        uint8_t x;
+        for (x = 0; x < KV_RECORD_HEADER_SIZE; x++)
+        {
+            if (reader.next(header[x]) == false)
+                break;
+        }
+        if (x < KV_RECORD_HEADER_SIZE)
+            break;
+
+        uint8_t keyLength = header[0];
+        uint8_t type = header[1];
+        uint16_t valueLength = header[2] | (header[3] << 8);
+        if (keyLength == 0 || keyLength > EXTERNAL_EEPROM_KV_MAX_KEY ||
+            (type != KV_RECORD_LIVE && type != KV_RECORD_TOMBSTONE))
+            break; // End of the log
+        if (recordLocation + getRecordSize(keyLength, valueLength) > halfEnd)
+            break;
+
+        uint16_t crc = externalEEPROMCrc16(0xFFFF, header, sizeof(header));
+        uint32_t hash = KV_HASH_SEED; // The key is hashed as it streams past, the same way as hashKey()
+        bool complete = true;
+        for (uint32_t y = 0; y < (uint32_t)keyLength + valueLength && complete == true; y++)
+        {
+            uint8_t value;
+            complete = reader.next(value);
+            crc = externalEEPROMCrc16(crc, &value, 1);
+            if (y < keyLength)
+                hash = hashStep(hash, value);
+        }
+        uint8_t storedCrc[KV_RECORD_CRC_SIZE];
+        if (complete == false || reader.next(storedCrc[0]) == false || reader.next(storedCrc[1]) == false)
+            break;
+        if (crc != (storedCrc[0] | (storedCrc[1] << 8)))
+            break; // Torn append
+
+        if (indexRecord(hash, recordLocation, valueLength, keyLength, type == KV_RECORD_TOMBSTONE) == false)
+            return (false); // Index is full
+        recordLocation += getRecordSize(keyLength, valueLength);
+    }
+
+    if (lastHalf == true)
+        appendLocation = recordLocation;
+    return (true);
+}
+
+void ExternalEEPROMKV::clearIndex()
+{
+    memset(index, 0, indexSize * sizeof(struct_kvEntry));
+    usedEntries = 0;
+    keyCount = 0;
+    liveBytes = 0;
+    phase = KV_IDLE;
+}
+
+// Point the key's index entry at a new record or tombstone
+bool ExternalEEPROMKV::indexRecord(uint32_t hash, uint32_t location, uint16_t valueLength, uint8_t keyLength,
+                                   bool tombstone)
+{
+    struct_kvEntry *entry = findEntry(hash);
+    if (entry == nullptr)
+        return (false);
+
+    if (entry->state == KV_ENTRY_LIVE)
+    {
+        liveBytes -= getRecordSize(entry->keyLength, entry->valueLength);
+        keyCount--;
+    }
+    else if (entry->state == KV_ENTRY_EMPTY)
+    {
+        entry->hash = hash;
+        usedEntries++;
+    }
+
+    entry->location = location;
+    entry->valueLength = valueLength;
+    entry->keyLength = keyLength;
+    if (tombstone == true)
+        entry->state = KV_ENTRY_DELETED;
+    else
+    {
+        entry->state = KV_ENTRY_LIVE;
+        keyCount++;
+        liveBytes += getRecordSize(keyLength, valueLength);
+    }
+    return (true);
+}
+
+// Linear probe for the entry with this hash, or the empty slot where it would go
+// Returns nullptr only if the table is full and the hash is not in it
+ExternalEEPROMKV::struct_kvEntry *ExternalEEPROMKV::findEntry(uint32_t hash)
+{
+    uint16_t mask = indexSize - 1;
+    uint16_t slot = hash & mask;
+    for (uint16_t x = 0; x < indexSize; x++)
+    {
+        struct_kvEntry *entry = &index[slot];
+        if (entry->state == KV_ENTRY_EMPTY || entry->hash == hash)
+            return (entry);
+        slot = (slot + 1) & mask;
+    }
+    return (nullptr);
+}
+
+// Return the live entry for key, or nullptr
+// The stored key is compared because different keys can share a hash
+ExternalEEPROMKV::struct_kvEntry *ExternalEEPROMKV::findLiveKey(const char *key, size_t keyLength)
+{
+    if (index == nullptr || keyLength == 0 || keyLength > EXTERNAL_EEPROM_KV_MAX_KEY)
+        return (nullptr);
+
+    struct_kvEntry *entry = findEntry(hashKey(key, keyLength));
+    if (entry == nullptr || entry->state != KV_ENTRY_LIVE || entry->keyLength != keyLength)
+        return (nullptr);
+    if (isKeyAt(key, keyLength, entry->location) == false)
+        return (nullptr);
+    return (entry);
+}
+
+// Compare a key against the one stored in the record at location
+bool ExternalEEPROMKV::isKeyAt(const char *key, uint8_t keyLength, uint32_t location)
+{
+    uint8_t stored[KV_RECORD_HEADER_SIZE + EXTERNAL_EEPROM_KV_MAX_KEY];
+    eeprom->read(location, stored, KV_RECORD_HEADER_SIZE + keyLength);
+    return (stored[0] == keyLength && memcmp(stored + KV_RECORD_HEADER_SIZE, key, keyLength) == 0);
+}
+
+// Stage a record one page at a time so each touched page is recorded with one write
+bool ExternalEEPROMKV::appendRecord(const char *key, uint8_t keyLength, const uint8_t *value, uint16_t valueLength,
+                                    bool tombstone, uint32_t &location)
+{
+    uint8_t header[KV_RECORD_HEADER_SIZE];
+    header[0] = keyLength;
+    header[1] = tombstone ? KV_RECORD_TOMBSTONE : KV_RECORD_LIVE;
+    header[2] = valueLength & 0xFF;
+    header[3] = valueLength >> 8;
+
+    uint16_t crc = externalEEPROMCrc16(0xFFFF, header, sizeof(header));
+    crc = externalEEPROMCrc16(crc, (const uint8_t *)key, keyLength);
+    crc = externalEEPROMCrc16(crc, value, valueLength);
+    uint8_t crcBytes[KV_RECORD_CRC_SIZE] = {(uint8_t)(crc & 0xFF), (uint8_t)(crc >> 8)};
+
+    location = appendLocation;
+    stageLocation = appendLocation;
+    stageLength = 0;
+    stage(header, sizeof(header));
+    stage((const uint8_t *)key, keyLength);
+    stage(value, valueLength);
+    stage(crcBytes, sizeof(crcBytes));
+    flushStage();
+
+    appendLocation += getRecordSize(keyLength, valueLength);
+    return (true);
+}
+
+// Make sure a record fits in the active half, compacting if it doesn't
+// Starts a background compaction once the half is 3/4 used and at least 1/4 of it is garbage
+bool ExternalEEPROMKV::makeRoom(uint32_t recordSize, bool newEntry)
+{
+    if (newEntry == true && usedEntries >= maxKeys)
+    {
+        if (usedEntries == keyCount)
+            return (false); // Every entry is a live key
+        compact();          // Drops deleted keys from the index
+        if (usedEntries >= maxKeys)
+            return (false);
+    }
+
+    // While copying, the new half must keep room for the records still to be moved
+    uint32_t reserved = 0;
+    if (phase == KV_COPYING)
+    {
+        for (uint16_t x = 0; x < indexSize; x++)
+        {
+            uint32_t location = index[x].location;
+            if (index[x].state == KV_ENTRY_LIVE && location >= getHalfStart(oldHalf) &&
+                location < getHalfStart(oldHalf) + halfSize)
+                reserved += getRecordSize(index[x].keyLength, index[x].valueLength);
+        }
+    }
+
+    if (recordSize + reserved > getFreeBytes())
+    {
+        compact();
+        if (recordSize > getFreeBytes())
+            return (false);
+    }
+    else if (phase == KV_IDLE && getFreeBytes() < halfSize / 4)
+    {
+        uint32_t used = halfSize - KV_HEADER_SIZE - getFreeBytes();
+        if (used - liveBytes >= halfSize / 4)
+            startCompaction();
+    }
+    return (true);
+}
+
+void ExternalEEPROMKV::stage(const uint8_t *data, uint32_t length)
+{
+    while (length > 0)
+    {
+        uint16_t room = pageSize - ((stageLocation + stageLength) % pageSize);
+        uint16_t amtToCopy = length < room ? length : room;
+        memcpy(stageBuffer + stageLength, data, amtToCopy);
+        stageLength += amtToCopy;
+        data += amtToCopy;
+        length -= amtToCopy;
+
+        if (amtToCopy == room)
+            flushStage(); // Reached the end of the page
+    }
+}
+
+void ExternalEEPROMKV::flushStage()
+{
+    if (stageLength == 0)
+        return;
+    eeprom->write(stageLocation, stageBuffer, stageLength);
+    stageLocation += stageLength;
+    stageLength = 0;
+}
+
+void ExternalEEPROMKV::startCompaction()
+{
+    eraseLocation = getHalfStart(1 - activeHalf);
+    phase = KV_ERASING;
+}
+
+void ExternalEEPROMKV::compactionStep()
+{
+    if (phase == KV_ERASING)
+    {
+        // The header page goes first so an interrupted erase leaves no valid header behind
+        eeprom->fill(eraseLocation, pageSize, 0xFF);
+        eraseLocation += pageSize;
+        if (eraseLocation < getHalfStart(1 - activeHalf) + halfSize)
+            return;
+
+        // New appends go to the new half from now on
+        oldHalf = activeHalf;
+        activeHalf = 1 - activeHalf;
+        generation++;
+        writeHeader(activeHalf, generation, false);
+        appendLocation = getHalfStart(activeHalf) + KV_HEADER_SIZE;
+        copyIndex = 0;
+        phase = KV_COPYING;
+        return;
+    }
+
+    if (phase != KV_COPYING)
+        return;
+
+    // Move the next live record that is still in the old half
+    while (copyIndex < indexSize)
+    {
+        struct_kvEntry *entry = &index[copyIndex++];
+        if (entry->state != KV_ENTRY_LIVE || entry->location < getHalfStart(oldHalf) ||
+            entry->location >= getHalfStart(oldHalf) + halfSize)
+            continue;
+
+        uint32_t recordSize = getRecordSize(entry->keyLength, entry->valueLength);
+        if (recordSize > getFreeBytes())
+        {
+            phase = KV_IDLE; // Out of room. Both halves are replayed at the next begin().
+            return;
+        }
+
+        uint32_t source = entry->location;
+        entry->location = appendLocation;
+        stageLocation = appendLocation;
+        stageLength = 0;
+        uint8_t buff[I2C_BUFFER_LENGTH_RX];
+        for (uint32_t copied = 0; copied < recordSize;)
+        {
+            uint16_t amtToCopy = recordSize - copied < sizeof(buff) ? recordSize - copied : sizeof(buff);
+            eeprom->read(source + copied, buff, amtToCopy);
+            stage(buff, amtToCopy);
+            copied += amtToCopy;
+        }
+        flushStage();
+        appendLocation += recordSize;
+        return;
+    }
+
+    // Everything is moved. Mark the new half complete, then rebuild the index without deleted keys.
+    eeprom->write(getHalfStart(activeHalf) + KV_HEADER_STATE, (uint8_t)0x00);
+    phase = KV_IDLE;
+    mount();
+}
+
+void ExternalEEPROMKV::writeHeader(uint8_t half, uint32_t generation, bool complete)
+{
+    uint8_t header[KV_HEADER_STATE + 1];
+    uint32_t magic = KV_MAGIC;
+    memcpy(header, &magic, sizeof(magic));
+    memcpy(header + 4, &generation, sizeof(generation));
+    uint32_t crc = externalEEPROMCrc32(0, header, 8);
+    memcpy(header + 8, &crc, sizeof(crc));
+    header[KV_HEADER_STATE] = complete ? 0x00 : 0xFF;
+    eeprom->write(getHalfStart(half), header, sizeof(header));
+}
+
+uint32_t ExternalEEPROMKV::getHalfStart(uint8_t half)
+{
+    return (regionStart + half * halfSize);
+}
+
+uint32_t ExternalEEPROMKV::getRecordSize(uint8_t keyLength, uint16_t valueLength)
+{
+    return (KV_RECORD_HEADER_SIZE + keyLength + valueLength + KV_RECORD_CRC_SIZE);
+}
+
+// FNV-1a
+uint32_t ExternalEEPROMKV::hashKey(const char *key, uint8_t keyLength)
+{
+    uint32_t hash = KV_HASH_SEED;
+    for (uint8_t x = 0; x < keyLength; x++)
+        hash = hashStep(hash, (uint8_t)key[x]);
+    return (hash);
+}
+
+// Fold one more key byte into an FNV-1a hash started at KV_HASH_SEED
+uint32_t ExternalEEPROMKV::hashStep(uint32_t hash, uint8_t value)
+{
+    return ((hash ^ value) * KV_HASH_PRIME);
+}
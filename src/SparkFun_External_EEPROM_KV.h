@@ -0,0 +1,136 @@
+/*
+  Key-value store for the SparkFun External EEPROM library.
+
+  Named values are appended to a log in one half of a region. Updates append a
+  new record and deletes append a tombstone, so nothing is rewritten in place.
+  Records are staged in a page buffer so each update costs one write cycle per
+  page it touches (usually one).
+
+  When the log fills up it is compacted into the other (spare) half: the spare
+  half is erased, the live records are copied, and the spare half becomes active.
+  update() does this one page or record at a time in the background. Updates made
+  while compacting go straight to the new half. A compaction interrupted by a
+  power loss is picked up again at begin().
+
+  begin() rebuilds a RAM hash index from a single sequential read of the log.
+  The index holds a 32-bit hash, location, and length per key, so get() is two
+  bus reads: the stored key, to confirm the match, then the value. put() refuses
+  a new key whose hash matches a different key already stored.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#ifndef _SPARKFUN_EXTERNAL_EEPROM_KV_H
+#define _SPARKFUN_EXTERNAL_EEPROM_KV_H
+
+#include "SparkFun_External_EEPROM.h"
+
+#define EXTERNAL_EEPROM_KV_MAX_KEY 32 // Longest key in bytes
+
+class ExternalEEPROMKV
+{
+  public:
+    // Mount the store in a region of the EEPROM, formatting it if no store is found
+    // maxKeys sizes the RAM index (12 bytes per slot, about 4/3 slots per key). Deleted keys
+    // count against maxKeys until the next compaction. maxKeys may be up to 24575.
+    bool begin(ExternalEEPROM &eeprom, uint32_t regionStart, uint32_t regionLength, uint16_t maxKeys = 64);
+    void end(); // Finish any compaction and free the index
+
+    void format(); // Erase the region and start an empty store
+
+    bool put(const char *key, const uint8_t *value, uint16_t valueLength);
+    bool get(const char *key, uint8_t *value, uint16_t bufferSize, uint16_t *valueLength = nullptr);
+    bool remove(const char *key);
+    bool exists(const char *key);
+    uint16_t getValueLength(const char *key); // 0 if the key doesn't exist
+
+    template <typename T> bool put(const char *key, const T &t)
+    {
+        return (put(key, (const uint8_t *)&t, sizeof(T)));
+    }
+    template <typename T> bool get(const char *key, T &t)
+    {
+        uint16_t valueLength;
+        return (get(key, (uint8_t *)&t, sizeof(T), &valueLength) && valueLength == sizeof(T));
+    }
+
+    uint16_t getKeyCount();   // Live keys
+    uint32_t getFreeBytes();  // Room left in the active half
+    uint32_t getLiveBytes();  // Bytes of records that compaction would copy
+
+    void update();        // Call from loop() to advance a background compaction
+    bool compact();       // Start a compaction if needed and run it to completion
+    bool isCompacting();
+
+  private:
+    struct struct_kvEntry
+    {
+        uint32_t hash;
+        uint32_t location; // Record start, or tombstone start for deleted keys
+        uint16_t valueLength;
+        uint8_t keyLength;
+        uint8_t state;
+    };
+
+    enum kvPhase
+    {
+        KV_IDLE,
+        KV_ERASING, // Clearing the spare half a page at a time
+        KV_COPYING, // Moving live records from the old half
+    };
+
+    bool mount();
+    void clearIndex();
+    bool replay(uint8_t half, bool lastHalf);
+    bool indexRecord(uint32_t hash, uint32_t location, uint16_t valueLength, uint8_t keyLength, bool tombstone);
+    struct_kvEntry *findEntry(uint32_t hash);
+    struct_kvEntry *findLiveKey(const char *key, size_t keyLength);
+    bool isKeyAt(const char *key, uint8_t keyLength, uint32_t location);
+
+    bool appendRecord(const char *key, uint8_t keyLength, const uint8_t *value, uint16_t valueLength,
+                      bool tombstone, uint32_t &location);
+    bool makeRoom(uint32_t recordSize, bool newKey);
+    void stage(const uint8_t *data, uint32_t length);
+    void flushStage();
+
+    void startCompaction();
+    void compactionStep();
+    void writeHeader(uint8_t half, uint32_t generation, bool complete);
+
+    uint32_t getHalfStart(uint8_t half);
+    uint32_t getRecordSize(uint8_t keyLength, uint16_t valueLength);
+    static uint32_t hashKey(const char *key, uint8_t keyLength);
+    static uint32_t hashStep(uint32_t hash, uint8_t value);
+
+    ExternalEEPROM *eeprom = nullptr;
+    uint32_t regionStart = 0;
+    uint32_t halfSize = 0;
+    uint16_t pageSize = 0;
+
+    struct_kvEntry *index = nullptr;
+    uint16_t indexSize = 0; // Power of two
+    uint16_t maxKeys = 0;
+    uint16_t usedEntries = 0; // Live and deleted
+    uint16_t keyCount = 0;
+    uint32_t liveBytes = 0;
+
+    uint8_t activeHalf = 0; // Half that receives appends
+    uint32_t generation = 0;
+    uint32_t appendLocation = 0;
+
+    uint8_t *stageBuffer = nullptr; // One page of a record being appended
+    uint32_t stageLocation = 0;
+    uint16_t stageLength = 0;
+
+    kvPhase phase = KV_IDLE;
+    uint8_t oldHalf = 0;
+    uint32_t eraseLocation = 0;
+    uint16_t copyIndex = 0;
+};
+
+#endif //_SPARKFUN_EXTERNAL_EEPROM_KV_H
@@ -0,0 +1,153 @@
+/*
+  LZ codec for the SparkFun External EEPROM library.
+
+  The encoder checks every position in the window, nearest first, testing the byte
+  that would extend the best match so far before comparing the rest. This keeps the
+  encoder table free; most candidates are rejected on one compare.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#include "SparkFun_External_EEPROM_LZ.h"
+
+#if EXTERNAL_EEPROM_LZ_WINDOW < 2 || EXTERNAL_EEPROM_LZ_WINDOW > 256
+#error "EXTERNAL_EEPROM_LZ_WINDOW must be 2 to 256"
+#endif
+
+// Return the length of the longest match for data[position] in the window, or 0 if it is too short to encode
+static uint8_t findMatch(const uint8_t *data, uint16_t length, uint16_t position, uint8_t &offset)
+{
+    uint16_t maxLength = length - position;
+    if (maxLength > EXTERNAL_EEPROM_LZ_MAX_MATCH)
+        maxLength = EXTERNAL_EEPROM_LZ_MAX_MATCH;
+    if (maxLength < EXTERNAL_EEPROM_LZ_MIN_MATCH)
+        return (0);
+
+    uint16_t windowStart = 0;
+    if (position > EXTERNAL_EEPROM_LZ_WINDOW)
+        windowStart = position - EXTERNAL_EEPROM_LZ_WINDOW;
+
+    const uint8_t *target = data + position;
+    uint8_t bestLength = 0;
+    for (uint16_t candidate = position; candidate-- > windowStart;)
+    {
+        const uint8_t *source = data + candidate;
+        if (source[bestLength] != target[bestLength] || source[0] != target[0])
+            continue;
+
+        // May run past position. The decoder copies a byte at a time so overlapping runs work.
+        uint8_t matchLength = 1;
+        while (matchLength < maxLength && source[matchLength] == target[matchLength])
+            matchLength++;
+
+        if (matchLength > bestLength)
+        {
+            bestLength = matchLength;
+            offset = position - candidate - 1;
+            if (bestLength == maxLength)
+                break; // Can't do better
+        }
+    }
+
+    if (bestLength < EXTERNAL_EEPROM_LZ_MIN_MATCH)
+        return (0);
+    return (bestLength);
+}
+
+uint16_t externalEEPROMLzCompress(const uint8_t *data, uint16_t length, uint16_t &position, uint8_t *out,
+                                  uint16_t outSize)
+{
+    uint16_t produced = 0;
+    uint8_t offset = 0;
+    uint8_t matchLength = findMatch(data, length, position, offset);
+
+    while (position < length && outSize - produced >= 2)
+    {
+        if (matchLength > 0)
+        {
+            out[produced++] = 0x80 | (matchLength - EXTERNAL_EEPROM_LZ_MIN_MATCH);
+            out[produced++] = offset;
+            position += matchLength;
+            matchLength = findMatch(data, length, position, offset);
+            continue;
+        }
+
+        // Gather literals until the next match, the end of the data, or the end of out
+        uint16_t control = produced++;
+        uint8_t literals = 0;
+        do
+        {
+            out[produced++] = data[position++];
+            literals++;
+            matchLength = findMatch(data, length, position, offset);
+        } while (matchLength == 0 && position < length && literals < EXTERNAL_EEPROM_LZ_MAX_LITERALS &&
+                 produced < outSize);
+        out[control] = literals - 1;
+    }
+
+    return (produced);
+}
+
+void externalEEPROMLzBegin(struct_lzDecoder &decoder)
+{
+    decoder.produced = 0;
+    decoder.state = 0;
+    decoder.remaining = 0;
+}
+
+bool externalEEPROMLzDecompress(struct_lzDecoder &decoder, const uint8_t *in, uint16_t inLength, uint8_t *out,
+                                uint16_t outSize)
+{
+    for (uint16_t x = 0; x < inLength; x++)
+    {
+        if (decoder.produced >= outSize)
+            break; // Anything after this is past the end of the stream or not wanted
+
+        uint8_t value = in[x];
+
+        if (decoder.state == 0) // Token
+        {
+            if (value & 0x80)
+            {
+                decoder.remaining = (value & 0x7F) + EXTERNAL_EEPROM_LZ_MIN_MATCH;
+                decoder.state = 2;
+            }
+            else
+            {
+                decoder.remaining = value + 1;
+                decoder.state = 1;
+            }
+        }
+        else if (decoder.state == 1) // Literal
+        {
+            out[decoder.produced++] = value;
+            if (--decoder.remaining == 0)
+                decoder.state = 0;
+        }
+        else if (decoder.state == 2) // Match offset
+        {
+            uint16_t distance = value + 1;
+            if (distance > decoder.produced)
+            {
+                decoder.state = 3;
+                return (false);
+            }
+
+            // Byte at a time so a match can overlap the bytes it produces
+            for (uint8_t y = 0; y < decoder.remaining && decoder.produced < outSize; y++)
+            {
+                out[decoder.produced] = out[decoder.produced - distance];
+                decoder.produced++;
+            }
+            decoder.state = 0;
+        }
+        else
+            return (false);
+    }
+    return (true);
+}
@@ -0,0 +1,62 @@
+/*
+  LZ codec for the SparkFun External EEPROM library.
+
+  Used by ExternalEEPROM::putCompressed()/getCompressed(). The format is a byte
+  aligned LZ77 with a small window so the decoder needs no tables and no window
+  buffer of its own: back references are copied out of the bytes already decoded.
+  A stream is a sequence of tokens:
+
+    0LLLLLLL                  - L + 1 literal bytes follow (1 to 128)
+    1LLLLLLL OOOOOOOO         - Copy L + 3 bytes (3 to 130) from O + 1 bytes back
+
+  Incompressible data grows by one byte in 128. The encoder is a greedy search of
+  the window. Define EXTERNAL_EEPROM_LZ_WINDOW (2 to 256) before including the
+  library (or in the build flags) to trade compression for encoder time; the
+  decoder reads any window up to 256.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#ifndef _SPARKFUN_EXTERNAL_EEPROM_LZ_H
+#define _SPARKFUN_EXTERNAL_EEPROM_LZ_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef EXTERNAL_EEPROM_LZ_WINDOW
+#define EXTERNAL_EEPROM_LZ_WINDOW 256
+#endif
+
+#define EXTERNAL_EEPROM_LZ_MIN_MATCH 3
+#define EXTERNAL_EEPROM_LZ_MAX_MATCH 130
+#define EXTERNAL_EEPROM_LZ_MAX_LITERALS 128
+
+// Decoder state so a stream can be fed in pieces as it comes off the bus
+struct struct_lzDecoder
+{
+    uint16_t produced;  // Bytes written to the output so far
+    uint8_t state;      // 0 - next byte is a token, 1 - literals, 2 - next byte is an offset, 3 - bad stream
+    uint8_t remaining;  // Literals left in the token, or the length of the match
+};
+
+// Compress data[position...length) into out until out is full or the data runs out.
+// Only whole tokens are written so out may be left one byte short. position is advanced past
+// the data consumed. Returns the number of bytes written to out.
+uint16_t externalEEPROMLzCompress(const uint8_t *data, uint16_t length, uint16_t &position, uint8_t *out,
+                                  uint16_t outSize);
+
+// Start a decoder before the first call to externalEEPROMLzDecompress()
+void externalEEPROMLzBegin(struct_lzDecoder &decoder);
+
+// Decode the next inLength bytes of a stream into out. out must hold everything decoded so far.
+// Stops once outSize bytes have been decoded; the rest of in is ignored.
+// Returns false if the stream refers back past the start of the output.
+bool externalEEPROMLzDecompress(struct_lzDecoder &decoder, const uint8_t *in, uint16_t inLength, uint8_t *out,
+                                uint16_t outSize);
+
+#endif //_SPARKFUN_EXTERNAL_EEPROM_LZ_H
@@ -0,0 +1,223 @@
+/*
+  Wear leveled, append-only record log for the SparkFun External EEPROM library.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#include "SparkFun_External_EEPROM_Log.h"
+
+#define LOG_ENTRY_OVERHEAD 5 // 4 byte sequence number and 1 byte checksum
+
+bool ExternalEEPROMLog::begin(ExternalEEPROM &eeprom, uint32_t regionStart, uint32_t regionLength,
+                              uint16_t recordSize)
+{
+    end();
+
+    this->eeprom = &eeprom;
+    pageSize = eeprom.getPageSizeBytes();
+    this->recordSize = recordSize;
+    entrySize = recordSize + LOG_ENTRY_OVERHEAD;
+    slotsPerPage = pageSize / entrySize;
+    if (slotsPerPage == 0)
+        return (false); // Record doesn't fit in a page
+
+    // Trim the region to whole pages
+    uint32_t regionEnd = regionStart + regionLength;
+    if (regionEnd > eeprom.length())
+        regionEnd = eeprom.length();
+    if (regionStart % pageSize != 0)
+        regionStart += pageSize - (regionStart % pageSize);
+    regionEnd -= regionEnd % pageSize;
+    if (regionEnd <= regionStart + pageSize)
+        return (false); // Need at least two pages so the newest records survive a wrap
+    this->regionStart = regionStart;
+    slotCount = ((regionEnd - regionStart) / pageSize) * slotsPerPage;
+
+    // The page buffer is followed by room for one entry used by read()
+    pageBuffer = (uint8_t *)malloc(pageSize + entrySize);
+    if (pageBuffer == nullptr)
+        return (false);
+
+    // Find the newest valid entry, reading a page at a time
+    uint32_t newestSlot = 0;
+    uint32_t newestSequence = 0;
+    for (uint32_t slot = 0; slot < slotCount; slot++)
+    {
+        uint8_t *entry = pageBuffer + (slot % slotsPerPage) * entrySize;
+        if (slot % slotsPerPage == 0)
+            eeprom.read(getSlotLocation(slot), pageBuffer, slotsPerPage * entrySize);
+
+        if (crc8(entry, entrySize - 1) != entry[entrySize - 1])
+            continue;
+        uint32_t sequence = getEntrySequence(entry);
+        if (sequence == 0xFFFFFFFF)
+            continue; // Erased, never written
+        if (sequence > newestSequence)
+        {
+            newestSequence = sequence;
+            newestSlot = slot;
+        }
+    }
+
+    headSlot = 0;
+    recordCount = 0;
+    nextSequence = 1;
+    pendingCount = 0;
+
+    if (newestSequence == 0)
+        return (true); // Empty log
+
+    headSlot = (newestSlot + 1) % slotCount;
+    nextSequence = newestSequence + 1;
+
+    // Count back from the newest entry while sequence numbers run without a gap
+    // Done as a second pass of page reads: the first slot (counting back) that breaks the run ends the log
+    uint32_t validRun = slotCount;
+    for (uint32_t slot = 0; slot < slotCount; slot++)
+    {
+        uint8_t *entry = pageBuffer + (slot % slotsPerPage) * entrySize;
+        if (slot % slotsPerPage == 0)
+            eeprom.read(getSlotLocation(slot), pageBuffer, slotsPerPage * entrySize);
+
+        uint32_t distance = (newestSlot + slotCount - slot) % slotCount; // 0 for the newest entry
+        if (distance >= validRun)
+            continue;
+        if (crc8(entry, entrySize - 1) != entry[entrySize - 1] || getEntrySequence(entry) != newestSequence - distance)
+            validRun = distance;
+    }
+    recordCount = validRun;
+
+    return (true);
+}
+
+void ExternalEEPROMLog::end()
+{
+    if (pageBuffer == nullptr)
+        return;
+
+    sync();
+    free(pageBuffer);
+    pageBuffer = nullptr;
+}
+
+// Erase the region so no old entries can be mistaken for log records
+void ExternalEEPROMLog::format()
+{
+    eeprom->fill(regionStart, (slotCount / slotsPerPage) * pageSize, 0xFF);
+    headSlot = 0;
+    recordCount = 0;
+    nextSequence = 1;
+    pendingCount = 0;
+}
+
+// Add a record to the head page. The page is recorded once all of its slots are used.
+bool ExternalEEPROMLog::append(const uint8_t *record)
+{
+    if (pageBuffer == nullptr)
+        return (false);
+
+    uint8_t *entry = pageBuffer + (headSlot % slotsPerPage) * entrySize;
+    memcpy(entry, &nextSequence, sizeof(nextSequence));
+    memcpy(entry + sizeof(nextSequence), record, recordSize);
+    entry[entrySize - 1] = crc8(entry, entrySize - 1);
+
+    if (pendingCount == 0)
+        pendingFirstSlot = headSlot;
+    pendingCount++;
+
+    nextSequence++;
+    headSlot = (headSlot + 1) % slotCount;
+    if (recordCount < slotCount)
+        recordCount++;
+
+    if (headSlot % slotsPerPage == 0)
+        return (sync() == 0); // Page is full
+
+    return (true);
+}
+
+// Record the entries gathered for the head page with a single write
+int ExternalEEPROMLog::sync()
+{
+    if (pendingCount == 0)
+        return (0);
+
+    uint16_t offset = (pendingFirstSlot % slotsPerPage) * entrySize;
+    int result = eeprom->write(getSlotLocation(pendingFirstSlot), pageBuffer + offset, pendingCount * entrySize);
+    pendingCount = 0;
+    return (result);
+}
+
+bool ExternalEEPROMLog::read(uint32_t index, uint8_t *record)
+{
+    if (index >= recordCount)
+        return (false);
+
+    uint32_t slot = (headSlot + slotCount - recordCount + index) % slotCount;
+
+    // Records not yet recorded are still in the page buffer
+    uint32_t pendingOffset = (slot + slotCount - pendingFirstSlot) % slotCount;
+    if (pendingCount > 0 && pendingOffset < pendingCount)
+    {
+        memcpy(record, pageBuffer + (slot % slotsPerPage) * entrySize + sizeof(uint32_t), recordSize);
+        return (true);
+    }
+
+    uint8_t *entry = pageBuffer + pageSize;
+    if (readSlot(slot, entry) == false)
+        return (false);
+    memcpy(record, entry + sizeof(uint32_t), recordSize);
+    return (true);
+}
+
+uint32_t ExternalEEPROMLog::getRecordCount()
+{
+    return (recordCount);
+}
+
+uint32_t ExternalEEPROMLog::getCapacity()
+{
+    return (slotCount);
+}
+
+uint32_t ExternalEEPROMLog::getSequence()
+{
+    return (nextSequence - 1);
+}
+
+uint32_t ExternalEEPROMLog::getSlotLocation(uint32_t slot)
+{
+    return (regionStart + (slot / slotsPerPage) * pageSize + (slot % slotsPerPage) * entrySize);
+}
+
+bool ExternalEEPROMLog::readSlot(uint32_t slot, uint8_t *entry)
+{
+    eeprom->read(getSlotLocation(slot), entry, entrySize);
+    return (crc8(entry, entrySize - 1) == entry[entrySize - 1]);
+}
+
+uint32_t ExternalEEPROMLog::getEntrySequence(const uint8_t *entry)
+{
+    uint32_t sequence;
+    memcpy(&sequence, entry, sizeof(sequence));
+    return (sequence);
+}
+
+// CRC-8, polynomial 0x07, initial value 0xFF, final XOR 0x01
+// With this start and finish, an erased (all 0xFF) or zeroed entry of any length never passes
+uint8_t ExternalEEPROMLog::crc8(const uint8_t *data, uint16_t length)
+{
+    uint8_t crc = 0xFF;
+    for (uint16_t x = 0; x < length; x++)
+    {
+        crc ^= data[x];
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+    }
+    return (crc ^ 0x01);
+}
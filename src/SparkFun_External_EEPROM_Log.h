@@ -0,0 +1,82 @@
+/*
+  Wear leveled, append-only record log for the SparkFun External EEPROM library.
+
+  Fixed size records are appended to a ring of pages inside a region of the EEPROM.
+  Records are gathered in RAM and recorded a full page at a time, so appending costs
+  about one write cycle per page of records instead of one per record. Every page of
+  the region is written in turn which spreads wear evenly across it.
+
+  Each record is stored as [sequence number][data][CRC-8]. At begin() the region is
+  scanned with one bulk read per page to find the newest record, so no index or
+  pointer needs to be stored (and worn out) on the device.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#ifndef _SPARKFUN_EXTERNAL_EEPROM_LOG_H
+#define _SPARKFUN_EXTERNAL_EEPROM_LOG_H
+
+#include "SparkFun_External_EEPROM.h"
+
+class ExternalEEPROMLog
+{
+  public:
+    // Attach to a region of the EEPROM and find the newest record in it
+    // The region is trimmed to whole pages. Records may not be larger than a page minus 5 bytes.
+    // Returns false if the region is too small or the page buffer could not be allocated.
+    bool begin(ExternalEEPROM &eeprom, uint32_t regionStart, uint32_t regionLength, uint16_t recordSize);
+    void end(); // Record anything pending and free the page buffer
+
+    void format(); // Erase the region and start an empty log
+
+    bool append(const uint8_t *record); // Queue a record. Full pages are recorded automatically.
+    int sync();                         // Record any partially filled page now
+
+    bool read(uint32_t index, uint8_t *record); // 0 is the oldest record still in the log
+
+    template <typename T> bool put(const T &record)
+    {
+        if (sizeof(T) != recordSize)
+            return (false);
+        return (append((const uint8_t *)&record));
+    }
+    template <typename T> bool get(uint32_t index, T &record)
+    {
+        if (sizeof(T) != recordSize)
+            return (false);
+        return (read(index, (uint8_t *)&record));
+    }
+
+    uint32_t getRecordCount(); // Records that can currently be read back
+    uint32_t getCapacity();    // Records the region can hold
+    uint32_t getSequence();    // Sequence number of the newest record, 0 if the log is empty
+
+  private:
+    uint32_t getSlotLocation(uint32_t slot);
+    bool readSlot(uint32_t slot, uint8_t *entry); // Returns true if the entry's checksum is good
+    uint32_t getEntrySequence(const uint8_t *entry);
+    uint8_t crc8(const uint8_t *data, uint16_t length);
+
+    ExternalEEPROM *eeprom = nullptr;
+    uint32_t regionStart = 0;
+    uint16_t pageSize = 0;
+    uint16_t recordSize = 0;
+    uint16_t entrySize = 0;    // Sequence number + record + checksum
+    uint16_t slotsPerPage = 0; // Entries never straddle a page
+    uint32_t slotCount = 0;
+
+    uint32_t headSlot = 0;     // Slot the next record goes into
+    uint32_t recordCount = 0;
+    uint32_t nextSequence = 1;
+
+    uint8_t *pageBuffer = nullptr; // Entries of the head page not yet recorded
+    uint32_t pendingFirstSlot = 0;
+    uint16_t pendingCount = 0;
+};
+
+#endif //_SPARKFUN_EXTERNAL_EEPROM_LOG_H
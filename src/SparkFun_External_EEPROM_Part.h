@@ -0,0 +1,319 @@
+/*
+  Compile-time device profiles for the SparkFun External EEPROM library.
+
+  ExternalEEPROMT<ExternalEEPROMPart::M24512> talks to a known part whose size, page
+  size, address width, and block select scheme are constants. Page splitting becomes
+  masks on a power of two page, the I2C address calculation for the part is the only
+  one compiled in, and code for other parts (block bits, 64k read barriers, one byte
+  addresses) is removed by the compiler.
+
+  It supports the core read/write/get/put API. Use the runtime ExternalEEPROM class for
+  auto-detection, caching, async writes, and the other extras.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#ifndef _SPARKFUN_EXTERNAL_EEPROM_PART_H
+#define _SPARKFUN_EXTERNAL_EEPROM_PART_H
+
+#include "SparkFun_External_EEPROM.h"
+
+namespace ExternalEEPROMPart
+{
+// Upper memory address bits beyond the address bytes go into the I2C address at blockSelectShift
+template <uint32_t memorySize, uint16_t pageSize, uint8_t addressSize, uint8_t blockSelectShift> struct Profile
+{
+    static constexpr uint32_t memorySize_bytes = memorySize;
+    static constexpr uint16_t pageSize_bytes = pageSize;
+    static constexpr uint8_t addressSize_bytes = addressSize;
+    static constexpr uint8_t blockSelectShift_bits = blockSelectShift;
+};
+
+struct M2400 : Profile<16, 1, 1, 0>
+{
+};
+struct M2401 : Profile<128, 8, 1, 0>
+{
+};
+struct M2402 : Profile<256, 8, 1, 0>
+{
+};
+struct M2404 : Profile<512, 16, 1, 0> // A8 in the A0 position
+{
+};
+struct M2408 : Profile<1024, 16, 1, 0> // A9/A8 in the A1/A0 positions
+{
+};
+struct M2416 : Profile<2048, 16, 1, 0> // A10/A9/A8 in the A2/A1/A0 positions
+{
+};
+struct M2432 : Profile<4096, 32, 2, 0>
+{
+};
+struct M2464 : Profile<8192, 32, 2, 0>
+{
+};
+struct M24128 : Profile<16384, 64, 2, 0>
+{
+};
+struct M24256 : Profile<32768, 64, 2, 0>
+{
+};
+struct M24512 : Profile<65536, 128, 2, 0>
+{
+};
+struct M241025 : Profile<131072, 128, 2, 2> // B0 in the A2 position
+{
+};
+struct M241026 : Profile<131072, 128, 2, 0> // A16 in the A0 position
+{
+};
+struct M24M02 : Profile<262144, 256, 2, 0> // A17/A16 in the A1/A0 positions
+{
+};
+} // namespace ExternalEEPROMPart
+
+template <class Part> class ExternalEEPROMT
+{
+    static_assert((Part::pageSize_bytes & (Part::pageSize_bytes - 1)) == 0, "Page size must be a power of two");
+
+  public:
+    bool begin(uint8_t deviceAddress = 0b1010000, TwoWire &wirePort = Wire, uint8_t WP = 255)
+    {
+        wireTransport.i2cPort = &wirePort;
+        return (begin(deviceAddress, wireTransport, WP));
+    }
+
+    bool begin(uint8_t deviceAddress, ExternalEEPROMTransport &transportPort, uint8_t WP = 255)
+    {
+        if (WP != 255)
+        {
+            pinMode(WP, OUTPUT);
+            digitalWrite(WP, HIGH);
+        }
+        wpPin = WP;
+        transport = &transportPort;
+        this->deviceAddress = deviceAddress;
+        return (isConnected());
+    }
+
+    bool isConnected()
+    {
+        transport->beginTransmission(deviceAddress);
+        return (transport->endTransmission() == 0);
+    }
+    bool isBusy()
+    {
+        return (isConnected() == false);
+    }
+
+    // Same busy polling as ExternalEEPROM::setPollPolicy()/setPollYield()
+    void setPollPolicy(const struct_pollPolicy &policy)
+    {
+        pollPolicy = policy;
+        if (pollPolicy.interval_us == 0)
+            pollPolicy.interval_us = 1;
+        if (pollPolicy.maxInterval_us < pollPolicy.interval_us)
+            pollPolicy.maxInterval_us = pollPolicy.interval_us;
+    }
+    struct_pollPolicy getPollPolicy()
+    {
+        return (pollPolicy);
+    }
+    void setPollYield(void (*yieldCallback)())
+    {
+        pollYield = yieldCallback;
+    }
+
+    static constexpr uint32_t length()
+    {
+        return (Part::memorySize_bytes);
+    }
+    static constexpr uint32_t getMemorySizeBytes()
+    {
+        return (Part::memorySize_bytes);
+    }
+    static constexpr uint16_t getPageSizeBytes()
+    {
+        return (Part::pageSize_bytes);
+    }
+    static constexpr uint8_t getAddressBytes()
+    {
+        return (Part::addressSize_bytes);
+    }
+
+    uint8_t read(uint32_t eepromLocation)
+    {
+        uint8_t tempByte;
+        read(eepromLocation, &tempByte, 1);
+        return tempByte;
+    }
+
+    // Bulk read, split at the I2C RX buffer and, on parts with block bits and two address bytes, at 64k blocks
+    int read(uint32_t eepromLocation, uint8_t *buff, uint16_t bufferSize)
+    {
+        int result = 0;
+
+        uint16_t received = 0;
+        while (received < bufferSize)
+        {
+            uint32_t location = eepromLocation + received;
+            uint16_t amtToRead = bufferSize - received;
+            if (amtToRead > I2C_BUFFER_LENGTH_RX)
+                amtToRead = I2C_BUFFER_LENGTH_RX;
+
+            if (hasReadBarrier)
+            {
+                uint32_t blockEnd = (location | 0xFFFF) + 1;
+                if (location + amtToRead > blockEnd)
+                    amtToRead = blockEnd - location;
+            }
+
+            uint8_t i2cAddress = getI2CAddress(location);
+
+            // A device still busy with a page write NACKs the address, so the transfer itself is the ACK poll
+            result = sendAddress(i2cAddress, location);
+            if (result == 2)
+            {
+                unsigned long wait_us = micros();
+                for (uint8_t polls = 0; result == 2; polls++)
+                {
+                    if (externalEEPROMBackOff(pollPolicy, wait_us, polls, pollYield) == false)
+                        return (EXTERNAL_EEPROM_TIMEOUT); // Still NACKing, so the device is missing or stuck
+                    result = sendAddress(i2cAddress, location);
+                }
+            }
+
+            transport->requestFrom(i2cAddress, (size_t)amtToRead);
+            for (uint16_t x = 0; x < amtToRead; x++)
+                buff[received + x] = transport->read();
+
+            received += amtToRead;
+        }
+
+        return (result);
+    }
+
+    int write(uint32_t eepromLocation, uint8_t dataToWrite)
+    {
+        if (read(eepromLocation) != dataToWrite) // Update only if data is new
+            return (write(eepromLocation, &dataToWrite, 1));
+        return (0);
+    }
+
+    int write(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t bufferSize)
+    {
+        int result = 0;
+
+        if (eepromLocation >= Part::memorySize_bytes)
+            return (0);
+        if (eepromLocation + bufferSize > Part::memorySize_bytes)
+            bufferSize = Part::memorySize_bytes - eepromLocation;
+
+        uint16_t recorded = 0;
+        while (recorded < bufferSize)
+        {
+            uint32_t location = eepromLocation + recorded;
+
+            // Up to the page boundary, limited by the TX buffer
+            uint16_t amtToWrite = Part::pageSize_bytes - (location & pageMask);
+            if (amtToWrite > maxWriteSize)
+                amtToWrite = maxWriteSize;
+            if (amtToWrite > bufferSize - recorded)
+                amtToWrite = bufferSize - recorded;
+
+            // The device NACKs while it is busy with the previous page
+            result = writePage(location, dataToWrite + recorded, amtToWrite);
+            if (result == 2)
+            {
+                unsigned long wait_us = micros();
+                for (uint8_t polls = 0; result == 2; polls++)
+                {
+                    if (externalEEPROMBackOff(pollPolicy, wait_us, polls, pollYield) == false)
+                        return (EXTERNAL_EEPROM_TIMEOUT);
+                    result = writePage(location, dataToWrite + recorded, amtToWrite);
+                }
+            }
+
+            recorded += amtToWrite;
+        }
+
+        return (result);
+    }
+
+    template <typename T> T &get(uint32_t idx, T &t)
+    {
+        read(idx, (uint8_t *)&t, sizeof(T));
+        return t;
+    }
+
+    template <typename T> const T &put(uint32_t idx, const T &t)
+    {
+        write(idx, (const uint8_t *)&t, sizeof(T));
+        return t;
+    }
+
+  private:
+    static constexpr uint32_t pageMask = Part::pageSize_bytes - 1;
+    static constexpr uint16_t maxWriteSize = Part::pageSize_bytes < I2C_BUFFER_LENGTH_TX - Part::addressSize_bytes
+                                                 ? Part::pageSize_bytes
+                                                 : I2C_BUFFER_LENGTH_TX - Part::addressSize_bytes;
+    static constexpr uint8_t addressBits = Part::addressSize_bytes * 8;
+    static constexpr bool hasBlockBits = Part::memorySize_bytes > (1UL << addressBits);
+    static constexpr bool hasReadBarrier = hasBlockBits && Part::addressSize_bytes == 2;
+
+    uint8_t getI2CAddress(uint32_t eepromLocation)
+    {
+        if (hasBlockBits)
+            return (deviceAddress | ((eepromLocation >> addressBits) << Part::blockSelectShift_bits));
+        return (deviceAddress);
+    }
+
+    uint8_t sendAddress(uint8_t i2cAddress, uint32_t eepromLocation)
+    {
+        transport->beginTransmission(i2cAddress);
+        if (Part::addressSize_bytes > 1)
+            transport->write((uint8_t)(eepromLocation >> 8)); // MSB
+        transport->write((uint8_t)(eepromLocation & 0xFF));   // LSB
+        return (transport->endTransmission(false));
+    }
+
+    int writePage(uint32_t eepromLocation, const uint8_t *dataToWrite, uint16_t amtToWrite)
+    {
+        if (wpPin != 255)
+            digitalWrite(wpPin, LOW);
+
+        transport->beginTransmission(getI2CAddress(eepromLocation));
+        if (Part::addressSize_bytes > 1)
+            transport->write((uint8_t)(eepromLocation >> 8)); // MSB
+        transport->write((uint8_t)(eepromLocation & 0xFF));   // LSB
+        transport->write(dataToWrite, amtToWrite);
+        int result = transport->endTransmission();
+
+        if (wpPin != 255)
+            digitalWrite(wpPin, HIGH);
+
+        return (result);
+    }
+
+    ExternalEEPROMWireTransport wireTransport;
+    ExternalEEPROMTransport *transport = &wireTransport;
+    uint8_t deviceAddress = 0b1010000;
+    uint8_t wpPin = 255;
+
+    struct_pollPolicy pollPolicy = {
+        .holdoff_us = 0, // Unused. There is no write time to hold off for.
+        .interval_us = 100,
+        .maxInterval_us = 1000,
+        .backoff = EXTERNAL_EEPROM_BACKOFF_EXPONENTIAL,
+        .timeout_us = 50000,
+    };
+    void (*pollYield)() = nullptr;
+};
+
+#endif //_SPARKFUN_EXTERNAL_EEPROM_PART_H
@@ -0,0 +1,193 @@
+/*
+  Image programmer for the SparkFun External EEPROM library.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#include "SparkFun_External_EEPROM_Programmer.h"
+
+bool ExternalEEPROMProgrammer::begin(ExternalEEPROM &eeprom)
+{
+    end();
+
+    this->eeprom = &eeprom;
+    pageSize = eeprom.getPageSizeBytes();
+
+    pages = (uint8_t *)malloc(3 * (uint32_t)pageSize);
+    if (pages == nullptr)
+        return (false);
+    return (true);
+}
+
+void ExternalEEPROMProgrammer::end()
+{
+    free(pages);
+    pages = nullptr;
+}
+
+void ExternalEEPROMProgrammer::setSkipUnchanged(bool skip)
+{
+    skipUnchanged = skip;
+}
+
+void ExternalEEPROMProgrammer::setVerify(bool verify, uint8_t maxRetries)
+{
+    this->verify = verify;
+    verifyRetries = maxRetries;
+}
+
+void ExternalEEPROMProgrammer::setProgressCallback(void (*progressCallback)(uint32_t bytesDone,
+                                                                           uint32_t bytesTotal))
+{
+    this->progressCallback = progressCallback;
+}
+
+bool ExternalEEPROMProgrammer::program(uint32_t eepromLocation, Stream &source, uint32_t length)
+{
+    sourceStream = &source;
+    sourceCallback = nullptr;
+    return (run(eepromLocation, length));
+}
+
+bool ExternalEEPROMProgrammer::program(uint32_t eepromLocation, uint16_t (*source)(uint8_t *buffer, uint16_t length),
+                                       uint32_t length)
+{
+    sourceStream = nullptr;
+    sourceCallback = source;
+    return (run(eepromLocation, length));
+}
+
+struct_programmerStats ExternalEEPROMProgrammer::getStats()
+{
+    return (stats);
+}
+
+uint32_t ExternalEEPROMProgrammer::getBytesPerSecond()
+{
+    if (stats.elapsed_ms == 0)
+        return (0);
+    return ((uint64_t)stats.bytes * 1000 / stats.elapsed_ms);
+}
+
+// Page N is written, then page N+1 is read from the source while N programs. Only then is the device
+// needed again: page N is read back and page N+1 is compared, waiting out whatever is left of tWR.
+bool ExternalEEPROMProgrammer::run(uint32_t eepromLocation, uint32_t length)
+{
+    memset(&stats, 0, sizeof(stats));
+    if (pages == nullptr)
+        return (false);
+
+    unsigned long startTime = millis();
+
+    if (eepromLocation >= eeprom->length())
+        length = 0;
+    else if (eepromLocation + length > eeprom->length())
+        length = eeprom->length() - eepromLocation;
+
+    uint8_t *current = pages;
+    uint8_t *previous = pages + pageSize;
+    uint8_t *device = pages + 2 * pageSize;
+
+    uint32_t previousLocation = 0;
+    uint16_t previousLength = 0; // 0 when the previous page was skipped
+    bool success = true;
+
+    // First page, up to the first page boundary
+    uint32_t location = eepromLocation;
+    uint16_t amount = pageSize - (location % pageSize);
+    if (amount > length)
+        amount = length;
+    amount = readSource(current, amount);
+
+    while (amount > 0)
+    {
+        // Finish the previous page now that its write cycle has (nearly) passed
+        if (previousLength > 0 && verify == true)
+        {
+            if (verifyPage(previousLocation, previous, previousLength) == false)
+                success = false;
+        }
+
+        bool skip = false;
+        if (skipUnchanged == true)
+        {
+            eeprom->read(location, device, amount);
+            skip = (memcmp(device, current, amount) == 0);
+        }
+
+        if (skip == true)
+        {
+            stats.pagesSkipped++;
+            previousLength = 0;
+        }
+        else
+        {
+            if (eeprom->write(location, current, amount) != 0)
+                success = false;
+            stats.pagesWritten++;
+            previousLocation = location;
+            previousLength = amount;
+        }
+        stats.bytes += amount;
+
+        if (progressCallback != nullptr)
+            progressCallback(stats.bytes, length);
+
+        // Swap buffers and fetch the next page while this one programs
+        uint8_t *swap = previous;
+        previous = current;
+        current = swap;
+
+        location += amount;
+        amount = pageSize;
+        if (amount > eepromLocation + length - location)
+            amount = eepromLocation + length - location;
+        if (amount > 0)
+            amount = readSource(current, amount); // A short read ends the image here
+    }
+
+    if (previousLength > 0 && verify == true)
+    {
+        if (verifyPage(previousLocation, previous, previousLength) == false)
+            success = false;
+    }
+
+    stats.elapsed_ms = millis() - startTime;
+    return (success);
+}
+
+uint16_t ExternalEEPROMProgrammer::readSource(uint8_t *buffer, uint16_t length)
+{
+    if (sourceStream != nullptr)
+        return (sourceStream->readBytes((char *)buffer, length));
+    if (sourceCallback != nullptr)
+        return (sourceCallback(buffer, length));
+    return (0);
+}
+
+// Read a written page back, rewriting it until it matches or the retries run out
+bool ExternalEEPROMProgrammer::verifyPage(uint32_t eepromLocation, const uint8_t *data, uint16_t length)
+{
+    uint8_t *device = pages + 2 * pageSize;
+
+    for (uint8_t attempt = 0;; attempt++)
+    {
+        eeprom->read(eepromLocation, device, length);
+        if (memcmp(device, data, length) == 0)
+            return (true);
+
+        if (attempt == verifyRetries)
+        {
+            stats.pagesFailed++;
+            return (false);
+        }
+
+        stats.pagesRewritten++;
+        eeprom->write(eepromLocation, data, length);
+    }
+}
@@ -0,0 +1,77 @@
+/*
+  Image programmer for the SparkFun External EEPROM library.
+
+  ExternalEEPROMProgrammer records an image from a Stream (ie, an SD card File) or a
+  callback, one device page at a time, with two page buffers:
+
+    - While a page programs (tWR), the next page is read from the source.
+    - Before a page is written it is read from the device and skipped if it already
+      holds the image. Re-flashing an image with small changes costs a read per page
+      instead of a write cycle per page.
+    - Each written page is read back once its write has finished, just before the next
+      page is compared, and rewritten if it doesn't match.
+
+  getStats() reports pages written, skipped, and rewritten, and the throughput.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#ifndef _SPARKFUN_EXTERNAL_EEPROM_PROGRAMMER_H
+#define _SPARKFUN_EXTERNAL_EEPROM_PROGRAMMER_H
+
+#include "SparkFun_External_EEPROM.h"
+
+struct struct_programmerStats
+{
+    uint32_t bytes;          // Image bytes taken from the source
+    uint32_t pagesWritten;   // Pages that differed and were recorded
+    uint32_t pagesSkipped;   // Pages that already held the image
+    uint32_t pagesRewritten; // Pages written again after reading back wrong
+    uint32_t pagesFailed;    // Pages that never read back correctly
+    uint32_t elapsed_ms;
+};
+
+class ExternalEEPROMProgrammer
+{
+  public:
+    bool begin(ExternalEEPROM &eeprom); // Allocates three pages
+    void end();
+
+    void setSkipUnchanged(bool skip);           // Compare each page before writing it. Default true.
+    void setVerify(bool verify, uint8_t maxRetries = 2); // Read back each written page. Default true.
+    void setProgressCallback(void (*progressCallback)(uint32_t bytesDone, uint32_t bytesTotal));
+
+    // Record length bytes from the source starting at eepromLocation. Stops early if the source runs dry.
+    // Returns false if a page could not be recorded correctly.
+    bool program(uint32_t eepromLocation, Stream &source, uint32_t length);
+    bool program(uint32_t eepromLocation, uint16_t (*source)(uint8_t *buffer, uint16_t length), uint32_t length);
+
+    struct_programmerStats getStats(); // For the last program()
+    uint32_t getBytesPerSecond();
+
+  private:
+    bool run(uint32_t eepromLocation, uint32_t length);
+    uint16_t readSource(uint8_t *buffer, uint16_t length);
+    bool verifyPage(uint32_t eepromLocation, const uint8_t *data, uint16_t length);
+
+    ExternalEEPROM *eeprom = nullptr;
+    uint16_t pageSize = 0;
+    uint8_t *pages = nullptr; // Two image pages, then one for device reads
+
+    Stream *sourceStream = nullptr;
+    uint16_t (*sourceCallback)(uint8_t *buffer, uint16_t length) = nullptr;
+    void (*progressCallback)(uint32_t bytesDone, uint32_t bytesTotal) = nullptr;
+
+    bool skipUnchanged = true;
+    bool verify = true;
+    uint8_t verifyRetries = 2;
+
+    struct_programmerStats stats = {};
+};
+
+#endif //_SPARKFUN_EXTERNAL_EEPROM_PROGRAMMER_H
@@ -0,0 +1,271 @@
+/*
+  Simulated 24xx I2C EEPROM for the SparkFun External EEPROM library.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#include "SparkFun_External_EEPROM_Simulator.h"
+#include <string.h>
+
+void SimulatedEEPROM::begin(uint8_t *memory, uint32_t memorySize_bytes, uint16_t pageSize_bytes,
+                            uint8_t addressSize_bytes, uint8_t deviceAddress)
+{
+    this->memory = memory;
+    this->memorySize_bytes = memorySize_bytes;
+    this->pageSize_bytes = pageSize_bytes;
+    if (this->pageSize_bytes == 0 || this->pageSize_bytes > SIMULATED_EEPROM_MAX_PAGE)
+        this->pageSize_bytes = 1;
+    this->addressSize_bytes = addressSize_bytes;
+    this->deviceAddress = deviceAddress;
+    blockBitCount = 0;
+    blockBitShift = 0;
+
+    memset(memory, 0xFF, memorySize_bytes);
+
+    busy = false;
+    addressPointer = 0;
+    txLength = 0;
+    rxLength = 0;
+    rxPosition = 0;
+    resetStats();
+}
+
+bool SimulatedEEPROM::begin(uint8_t *memory, uint16_t typeNumber, uint8_t deviceAddress)
+{
+    switch (typeNumber)
+    {
+    default:
+        // Unknown type number
+        return (false);
+    case (0):
+        begin(memory, 16, 1, 1, deviceAddress);
+        break;
+    case (1):
+        begin(memory, 128, 8, 1, deviceAddress);
+        break;
+    case (2):
+        begin(memory, 256, 8, 1, deviceAddress);
+        break;
+    case (4):
+        begin(memory, 512, 16, 1, deviceAddress);
+        setBlockSelect(1, 0);
+        break;
+    case (8):
+        begin(memory, 1024, 16, 1, deviceAddress);
+        setBlockSelect(2, 0);
+        break;
+    case (16):
+        begin(memory, 2048, 16, 1, deviceAddress);
+        setBlockSelect(3, 0);
+        break;
+    case (32):
+        begin(memory, 4096, 32, 2, deviceAddress);
+        break;
+    case (64):
+        begin(memory, 8192, 32, 2, deviceAddress);
+        break;
+    case (128):
+        begin(memory, 16384, 64, 2, deviceAddress);
+        break;
+    case (256):
+        begin(memory, 32768, 64, 2, deviceAddress);
+        break;
+    case (512):
+        begin(memory, 65536, 128, 2, deviceAddress);
+        break;
+    case (1025):
+        begin(memory, 131072, 128, 2, deviceAddress);
+        setBlockSelect(1, 2); // B0 sits in the A2 position
+        break;
+    case (1026):
+        begin(memory, 131072, 128, 2, deviceAddress);
+        setBlockSelect(1, 0); // A16 sits in the A0 position
+        break;
+    case (2048):
+        begin(memory, 262144, 256, 2, deviceAddress);
+        setBlockSelect(2, 0); // A17/A16 sit in the A1/A0 positions
+        break;
+    }
+    return (true);
+}
+
+void SimulatedEEPROM::setBlockSelect(uint8_t bitCount, uint8_t bitShift)
+{
+    blockBitCount = bitCount;
+    blockBitShift = bitShift;
+}
+
+void SimulatedEEPROM::setWriteTimeUs(uint32_t writeTime_us)
+{
+    this->writeTime_us = writeTime_us;
+}
+
+void SimulatedEEPROM::setBusClock(uint32_t clock_Hz)
+{
+    if (clock_Hz > 0)
+        busClock_Hz = clock_Hz;
+}
+
+void SimulatedEEPROM::setTimeSource(unsigned long (*timeSource_us)())
+{
+    this->timeSource_us = timeSource_us;
+}
+
+void SimulatedEEPROM::advanceTime(uint32_t time_us)
+{
+    virtualTime_us += time_us;
+}
+
+uint32_t SimulatedEEPROM::now()
+{
+    if (timeSource_us != nullptr)
+        return ((uint32_t)timeSource_us());
+    return (virtualTime_us);
+}
+
+// Returns true while a page program is in progress
+bool SimulatedEEPROM::isBusy()
+{
+    if (busy == true && (uint32_t)(now() - busyStart_us) >= writeTime_us)
+        busy = false;
+    return (busy);
+}
+
+struct_simulatedEEPROMStats SimulatedEEPROM::getStats()
+{
+    return (stats);
+}
+
+void SimulatedEEPROM::resetStats()
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+// The device answers to its base address with any combination of block select bits
+bool SimulatedEEPROM::acceptsAddress(uint8_t i2cAddress)
+{
+    uint8_t blockMask = ((1 << blockBitCount) - 1) << blockBitShift;
+    return ((i2cAddress & ~blockMask) == (deviceAddress & ~blockMask));
+}
+
+uint32_t SimulatedEEPROM::blockOffset(uint8_t i2cAddress)
+{
+    uint8_t block = (i2cAddress >> blockBitShift) & ((1 << blockBitCount) - 1);
+    return ((uint32_t)block << (addressSize_bytes * 8));
+}
+
+// Each transaction costs a start, the address byte, the payload with ACK bits, and a stop
+void SimulatedEEPROM::chargeBus(uint32_t bytes)
+{
+    uint32_t bits = 9 * (bytes + 1) + 2;
+    uint32_t time_us = (bits * 1000000UL + busClock_Hz - 1) / busClock_Hz;
+
+    stats.transactions++;
+    stats.busTime_us += time_us;
+    if (timeSource_us == nullptr)
+        virtualTime_us += time_us;
+}
+
+void SimulatedEEPROM::beginTransmission(uint8_t i2cAddress)
+{
+    txAddress = i2cAddress;
+    txLength = 0;
+}
+
+size_t SimulatedEEPROM::write(uint8_t dataToWrite)
+{
+    if (txLength >= sizeof(txBuffer))
+        return (0);
+    txBuffer[txLength++] = dataToWrite;
+    return (1);
+}
+
+uint8_t SimulatedEEPROM::endTransmission(bool sendStop)
+{
+    if (acceptsAddress(txAddress) == false || isBusy() == true)
+    {
+        chargeBus(0); // The controller gives up after the NACKed address byte
+        stats.nacks++;
+        return (2); // Address NACK
+    }
+
+    chargeBus(txLength);
+    stats.bytesToDevice += txLength;
+
+    if (txLength == 0)
+        return (0); // Address only probe
+
+    // Load the word address counter
+    uint32_t wordAddress = 0;
+    uint16_t addressBytesReceived = txLength < addressSize_bytes ? txLength : addressSize_bytes;
+    for (uint16_t x = 0; x < addressBytesReceived; x++)
+        wordAddress = (wordAddress << 8) | txBuffer[x];
+    addressPointer = (blockOffset(txAddress) + wordAddress) % memorySize_bytes;
+
+    uint16_t dataLength = txLength - addressBytesReceived;
+    if (dataLength == 0 || sendStop == false)
+        return (0); // Address set for a following read. Data without a stop is never programmed.
+
+    // Program the page. Bytes that run off the end of the page wrap to its start.
+    uint32_t pageStart = addressPointer - (addressPointer % pageSize_bytes);
+    uint16_t pageOffset = addressPointer % pageSize_bytes;
+    for (uint16_t x = 0; x < dataLength; x++)
+    {
+        uint32_t location = pageStart + ((pageOffset + x) % pageSize_bytes);
+        if (location < memorySize_bytes)
+            memory[location] = txBuffer[addressBytesReceived + x];
+    }
+    addressPointer = pageStart + ((pageOffset + dataLength) % pageSize_bytes);
+
+    stats.pageWrites++;
+    busy = true;
+    busyStart_us = now();
+
+    return (0);
+}
+
+size_t SimulatedEEPROM::requestFrom(uint8_t i2cAddress, size_t length)
+{
+    rxLength = 0;
+    rxPosition = 0;
+
+    if (length > sizeof(rxBuffer))
+        length = sizeof(rxBuffer);
+
+    if (acceptsAddress(i2cAddress) == false || isBusy() == true)
+    {
+        chargeBus(0);
+        stats.nacks++;
+        return (0);
+    }
+
+    chargeBus(length);
+
+    // Sequential reads roll over at the end of a block on parts that use two address bytes plus block bits,
+    // otherwise at the end of the array
+    uint32_t wrapSize = memorySize_bytes;
+    if (addressSize_bytes == 2 && blockBitCount > 0)
+        wrapSize = 65536;
+    uint32_t wrapStart = addressPointer - (addressPointer % wrapSize);
+
+    for (size_t x = 0; x < length; x++)
+    {
+        rxBuffer[rxLength++] = memory[addressPointer];
+        addressPointer = wrapStart + ((addressPointer - wrapStart + 1) % wrapSize);
+    }
+
+    stats.bytesFromDevice += rxLength;
+    return (rxLength);
+}
+
+int SimulatedEEPROM::read()
+{
+    if (rxPosition >= rxLength)
+        return (-1);
+    return (rxBuffer[rxPosition++]);
+}
@@ -0,0 +1,109 @@
+/*
+  Simulated 24xx I2C EEPROM for the SparkFun External EEPROM library.
+
+  SimulatedEEPROM is an ExternalEEPROMTransport that behaves like a 24xx part
+  sitting on the bus, so ExternalEEPROM can be exercised and benchmarked without
+  hardware. It models:
+    Page buffer wrap: data written past the end of a page wraps to the start of that page
+    Block select: upper memory address bits carried in the I2C device address (24xx04/08/16, 1025, 1026, M02)
+    Word address wrap: address bits beyond the memory size are ignored, like real parts
+    Write cycle time: the device NACKs every transaction for tWR after a page program
+    Cost accounting: transactions, bytes, NACKs, page programs, and bus time at a given clock
+
+  The model only depends on the transport header so it can be built on a host.
+  By default time only advances with bus traffic (plus advanceTime()). Call
+  setTimeSource(micros) to make tWR track real or host-simulated time instead.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#ifndef _SPARKFUN_EXTERNAL_EEPROM_SIMULATOR_H
+#define _SPARKFUN_EXTERNAL_EEPROM_SIMULATOR_H
+
+#include "SparkFun_External_EEPROM_Transport.h"
+
+#define SIMULATED_EEPROM_MAX_PAGE 256 // Largest page of any known 24xx part (24xxM02)
+
+struct struct_simulatedEEPROMStats
+{
+    uint32_t transactions;    // Every start condition (writes, reads, and empty probes)
+    uint32_t bytesToDevice;   // Address and data bytes sent by the controller
+    uint32_t bytesFromDevice; // Data bytes returned to the controller
+    uint32_t nacks;           // Transactions rejected because of a busy device or wrong address
+    uint32_t pageWrites;      // Completed page program cycles
+    uint32_t busTime_us;      // Time the bus was occupied at the configured clock
+};
+
+class SimulatedEEPROM : public ExternalEEPROMTransport
+{
+  public:
+    // Attach backing storage and describe the part. The memory is set to 0xFF (erased).
+    void begin(uint8_t *memory, uint32_t memorySize_bytes, uint16_t pageSize_bytes, uint8_t addressSize_bytes,
+               uint8_t deviceAddress = 0b1010000);
+
+    // Configure as a known part. Valid types: 0, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1025, 1026, 2048
+    // memory must hold the full part (ie 131072 bytes for a 1025/1026). Returns false on unknown types.
+    bool begin(uint8_t *memory, uint16_t typeNumber, uint8_t deviceAddress = 0b1010000);
+
+    // Number of upper memory address bits carried in the device address, and the bit they start at
+    // 24xx04/08/16: 1/2/3 bits at bit 0. 24xx1025: 1 bit at bit 2. 24xx1026: 1 bit at bit 0. 24xxM02: 2 bits at bit 0.
+    void setBlockSelect(uint8_t bitCount, uint8_t bitShift);
+
+    void setWriteTimeUs(uint32_t writeTime_us); // tWR, the time the device NACKs after a page program
+    void setBusClock(uint32_t clock_Hz);        // Used to cost each transaction
+    void setTimeSource(unsigned long (*timeSource_us)()); // Pass micros to track real time. NULL uses the bus clock.
+    void advanceTime(uint32_t time_us);         // Move the internal clock forward (no effect with a time source)
+
+    bool isBusy();
+    uint32_t now(); // Current simulated time in us
+
+    struct_simulatedEEPROMStats getStats();
+    void resetStats();
+
+    // ExternalEEPROMTransport
+    using ExternalEEPROMTransport::write;
+    void beginTransmission(uint8_t i2cAddress);
+    size_t write(uint8_t dataToWrite);
+    uint8_t endTransmission(bool sendStop = true);
+    size_t requestFrom(uint8_t i2cAddress, size_t length);
+    int read();
+
+  private:
+    bool acceptsAddress(uint8_t i2cAddress);
+    uint32_t blockOffset(uint8_t i2cAddress); // Memory offset selected by the block bits of the device address
+    void chargeBus(uint32_t bytes);           // Account for one transaction of address + bytes
+
+    uint8_t *memory = nullptr;
+    uint32_t memorySize_bytes = 0;
+    uint16_t pageSize_bytes = 1;
+    uint8_t addressSize_bytes = 1;
+    uint8_t deviceAddress = 0b1010000;
+    uint8_t blockBitCount = 0;
+    uint8_t blockBitShift = 0;
+
+    uint32_t writeTime_us = 5000;
+    uint32_t busClock_Hz = 100000;
+    unsigned long (*timeSource_us)() = nullptr;
+    uint32_t virtualTime_us = 0;
+    uint32_t busyStart_us = 0;
+    bool busy = false;
+
+    uint32_t addressPointer = 0; // Internal word address counter
+
+    uint8_t txAddress = 0;
+    uint8_t txBuffer[SIMULATED_EEPROM_MAX_PAGE + 2]; // Page plus two address bytes
+    uint16_t txLength = 0;
+
+    uint8_t rxBuffer[SIMULATED_EEPROM_MAX_PAGE];
+    uint16_t rxLength = 0;
+    uint16_t rxPosition = 0;
+
+    struct_simulatedEEPROMStats stats = {};
+};
+
+#endif //_SPARKFUN_EXTERNAL_EEPROM_SIMULATOR_H
@@ -0,0 +1,192 @@
+/*
+  Stream adapter for the SparkFun External EEPROM library.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#include "SparkFun_External_EEPROM_Stream.h"
+
+bool ExternalEEPROMStream::begin(ExternalEEPROM &eeprom, uint32_t regionStart, uint32_t regionLength)
+{
+    end();
+
+    this->eeprom = &eeprom;
+    if (regionStart >= eeprom.length())
+        return (false);
+    if (regionStart + regionLength > eeprom.length())
+        regionLength = eeprom.length() - regionStart;
+    this->regionStart = regionStart;
+    this->regionLength = regionLength;
+    pageSize = eeprom.getPageSizeBytes();
+
+    writeBuffer = (uint8_t *)malloc(pageSize);
+    readBuffer = (uint8_t *)malloc(I2C_BUFFER_LENGTH_RX);
+    if (writeBuffer == nullptr || readBuffer == nullptr)
+    {
+        end();
+        return (false);
+    }
+
+    position = 0;
+    writeLength = 0;
+    readLength = 0;
+    return (true);
+}
+
+void ExternalEEPROMStream::end()
+{
+    if (writeBuffer != nullptr)
+        flush();
+    free(writeBuffer);
+    writeBuffer = nullptr;
+    free(readBuffer);
+    readBuffer = nullptr;
+}
+
+bool ExternalEEPROMStream::seek(uint32_t position)
+{
+    if (position > regionLength)
+        return (false);
+    flush();
+    this->position = position;
+    return (true);
+}
+
+uint32_t ExternalEEPROMStream::tell()
+{
+    return (position);
+}
+
+uint32_t ExternalEEPROMStream::size()
+{
+    return (regionLength);
+}
+
+int ExternalEEPROMStream::available()
+{
+    uint32_t remaining = regionLength - position;
+    if (remaining > 0x7FFF)
+        remaining = 0x7FFF; // int may be 16 bits
+    return (remaining);
+}
+
+int ExternalEEPROMStream::read()
+{
+    int value = peek();
+    if (value >= 0)
+        position++;
+    return (value);
+}
+
+int ExternalEEPROMStream::peek()
+{
+    if (readBuffer == nullptr || position >= regionLength)
+        return (-1);
+    if (position < readStart || position >= readStart + readLength)
+    {
+        if (fillReadBuffer() == false)
+            return (-1);
+    }
+    return (readBuffer[position - readStart]);
+}
+
+// Copy out of the read buffer, then read whole I2C bursts straight into the caller's buffer
+size_t ExternalEEPROMStream::read(uint8_t *buffer, size_t length)
+{
+    if (readBuffer == nullptr)
+        return (0);
+    if (length > regionLength - position)
+        length = regionLength - position;
+
+    flush(); // Reads must see pending writes
+
+    size_t received = 0;
+    if (position >= readStart && position < readStart + readLength)
+    {
+        received = readStart + readLength - position;
+        if (received > length)
+            received = length;
+        memcpy(buffer, readBuffer + (position - readStart), received);
+        position += received;
+    }
+
+    while (received < length)
+    {
+        uint16_t amtToRead = length - received < 0xFFFF ? length - received : 0xFFFF;
+        eeprom->read(regionStart + position, buffer + received, amtToRead);
+        received += amtToRead;
+        position += amtToRead;
+    }
+    return (received);
+}
+
+size_t ExternalEEPROMStream::write(uint8_t dataToWrite)
+{
+    return (write(&dataToWrite, 1));
+}
+
+// Gather bytes for the current page. The page is recorded once it is full, when a write
+// goes somewhere else, or on flush().
+size_t ExternalEEPROMStream::write(const uint8_t *dataToWrite, size_t length)
+{
+    if (writeBuffer == nullptr)
+        return (0);
+    if (length > regionLength - position)
+        length = regionLength - position;
+
+    size_t written = 0;
+    while (written < length)
+    {
+        if (writeLength > 0 && position != writeStart + writeLength)
+            flush(); // Not contiguous with the gathered bytes
+        if (writeLength == 0)
+            writeStart = position;
+
+        // Room left before the end of the device page holding writeStart
+        uint32_t location = regionStart + position;
+        uint16_t room = pageSize - (location % pageSize);
+        uint16_t amtToCopy = length - written < room ? length - written : room;
+        memcpy(writeBuffer + writeLength, dataToWrite + written, amtToCopy);
+        writeLength += amtToCopy;
+        written += amtToCopy;
+        position += amtToCopy;
+
+        if (amtToCopy == room)
+            flush(); // Page is complete
+    }
+    return (written);
+}
+
+void ExternalEEPROMStream::flush()
+{
+    if (writeLength == 0)
+        return;
+
+    eeprom->write(regionStart + writeStart, writeBuffer, writeLength);
+
+    // Drop buffered reads the write has made stale
+    if (writeStart < readStart + readLength && readStart < writeStart + writeLength)
+        readLength = 0;
+    writeLength = 0;
+}
+
+// Load the burst starting at the current position
+bool ExternalEEPROMStream::fillReadBuffer()
+{
+    flush(); // Reads must see pending writes
+
+    uint32_t amtToRead = regionLength - position;
+    if (amtToRead == 0)
+        return (false);
+    if (amtToRead > I2C_BUFFER_LENGTH_RX)
+        amtToRead = I2C_BUFFER_LENGTH_RX;
+    eeprom->read(regionStart + position, readBuffer, amtToRead);
+    readStart = position;
+    readLength = amtToRead;
+    return (true);
+}
@@ -0,0 +1,67 @@
+/*
+  Stream adapter for the SparkFun External EEPROM library.
+
+  ExternalEEPROMStream presents a region of the EEPROM as an Arduino Stream, so it
+  can be handed to print(), printf-style formatters, serializers, and parsers.
+
+  Bytes written are gathered in a page buffer and recorded one page at a time,
+  instead of a read-compare and a write cycle per byte. Reads are served from a
+  buffer filled one I2C read (I2C_BUFFER_LENGTH_RX bytes) at a time. Reading and
+  writing share one position, like a file. Call flush() to record a partly filled
+  page before power down or before handing the memory to other code.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#ifndef _SPARKFUN_EXTERNAL_EEPROM_STREAM_H
+#define _SPARKFUN_EXTERNAL_EEPROM_STREAM_H
+
+#include "SparkFun_External_EEPROM.h"
+
+class ExternalEEPROMStream : public Stream
+{
+  public:
+    // Use regionLength bytes starting at regionStart. Allocates a page and an I2C read buffer.
+    bool begin(ExternalEEPROM &eeprom, uint32_t regionStart, uint32_t regionLength);
+    void end(); // Flush and free the buffers
+
+    bool seek(uint32_t position); // Position within the region. Pending writes are flushed first.
+    uint32_t tell();
+    uint32_t size();
+
+    // Stream
+    int available(); // Bytes between the position and the end of the region
+    int read();
+    int peek();
+    size_t read(uint8_t *buffer, size_t length); // Bulk read, returns the number of bytes read
+
+    // Print
+    using Print::write;
+    size_t write(uint8_t dataToWrite);
+    size_t write(const uint8_t *dataToWrite, size_t length);
+    void flush(); // Record the partly filled page
+
+  private:
+    bool fillReadBuffer();
+
+    ExternalEEPROM *eeprom = nullptr;
+    uint32_t regionStart = 0;
+    uint32_t regionLength = 0;
+    uint32_t position = 0; // Relative to regionStart
+    uint16_t pageSize = 0;
+
+    uint8_t *writeBuffer = nullptr; // Bytes for the page holding writeStart
+    uint32_t writeStart = 0;        // Position of writeBuffer[0]
+    uint16_t writeLength = 0;
+
+    uint8_t *readBuffer = nullptr;
+    uint32_t readStart = 0; // Position of readBuffer[0]
+    uint16_t readLength = 0;
+};
+
+#endif //_SPARKFUN_EXTERNAL_EEPROM_STREAM_H
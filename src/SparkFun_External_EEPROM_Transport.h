@@ -0,0 +1,54 @@
+/*
+  Bus transport interface for the SparkFun External EEPROM library.
+
+  ExternalEEPROM does all of its bus traffic through this interface. By default
+  it talks to a TwoWire port, but any I2C driver (or the SimulatedEEPROM device
+  model) can be plugged in with begin(deviceAddress, transport).
+
+  The calls mirror the subset of the TwoWire API used by the library so a
+  transport is a thin shim over whatever bus driver is available. This header
+  deliberately does not depend on Arduino.h so device models can be built on a host.
+
+  https://github.com/sparkfun/SparkFun_External_EEPROM_Arduino_Library
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+*/
+
+#ifndef _SPARKFUN_EXTERNAL_EEPROM_TRANSPORT_H
+#define _SPARKFUN_EXTERNAL_EEPROM_TRANSPORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+class ExternalEEPROMTransport
+{
+  public:
+    // Start queuing a write transaction to the given 7-bit address
+    virtual void beginTransmission(uint8_t i2cAddress) = 0;
+
+    // Queue a byte. Returns the number of bytes queued (0 if the TX buffer is full).
+    virtual size_t write(uint8_t dataToWrite) = 0;
+
+    // Queue a block of bytes. Returns the number of bytes queued.
+    virtual size_t write(const uint8_t *dataToWrite, size_t length)
+    {
+        size_t written = 0;
+        while (written < length && write(dataToWrite[written]) == 1)
+            written++;
+        return (written);
+    }
+
+    // Send the queued transaction. Returns 0 on success, 2 on address NACK, 3 on data NACK, like TwoWire.
+    virtual uint8_t endTransmission(bool sendStop = true) = 0;
+
+    // Read length bytes from the given 7-bit address. Returns the number of bytes received.
+    virtual size_t requestFrom(uint8_t i2cAddress, size_t length) = 0;
+
+    // Return the next received byte, or -1 if none remain
+    virtual int read() = 0;
+};
+
+#endif //_SPARKFUN_EXTERNAL_EEPROM_TRANSPORT_H